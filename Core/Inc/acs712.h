@@ -3,49 +3,88 @@
 
 #include "stm32f1xx_hal.h"
 #include <stdint.h>
+#include <stdbool.h>
+#include "adc_scan.h"
 
 /* -------------------------------
  *  Global values (for display)
  * ------------------------------- */
-extern float g_currentA;   // Amperes
-extern float g_voltageV;   // Volts
+extern float g_currentA;   // Amperes RMS, same cycle window as voltage
+extern float g_voltageV;   // Volts RMS, refreshed every mains cycle
+extern float g_mainsHz;    // measured mains frequency (0 = no crossings)
+extern float g_powerW;     // active power, mean(v*i) over the same cycle
 
 /* -------------------- ADC CONFIG -------------------- */
 #define ADC_VREF   3.3f
 #define ADC_RES    4095.0f
 
+/* ----------------- V/I SAMPLE STREAM ----------------
+   V/I pairs are the first two ranks of every adc_scan
+   frame: TIM3 update (64 MHz / 20000) triggers one frame,
+   64 frames @ 3.2 kHz = 20 ms = one 50 Hz cycle.
+------------------------------------------------------ */
+#define MAINS_SAMPLE_RATE_HZ   3200
+#define MAINS_BLOCK_SAMPLES    ADC_SCAN_BLOCK_FRAMES
+
 /* ------------------ ACS712 CURRENT ------------------ */
 #define ACS712_ADC_CHANNEL     ADC_CHANNEL_7
-#define ACS712_ZERO_SAMPLES    10
-#define ACS712_FILTER_ALPHA    0.05f
-#define ACS712_SENS_30A        0.066f   // 66mV per Ampere for ACS712-30A
 
 /* ---------------- ZMPT101B VOLTAGE ------------------ */
 #define ZMPT_ADC_CHANNEL       ADC_CHANNEL_6
-#define ZMPT_OFFSET_SAMPLES    300
-#define ZMPT_RMS_SAMPLES       800
-#define ZMPT_FILTER_ALPHA      0.15f
 
-/* -----------------------------------------------------
-   CALIBRATION CONSTANT (YOU WILL UPDATE THIS)
-   AFTER YOU SEND ME:
-       1) Your ADC_RMS
-       2) Your Multimeter RMS
+/* zero-crossing cycle engine (3.2 kHz stream) */
+#define ZC_HYST_COUNTS         24       // ~20 mV below offset arms a crossing
+#define ZC_MIN_SAMPLES         40       // 80 Hz – shorter cycles are glitches
+#define ZC_MAX_SAMPLES         80       // 40 Hz – longer means mains lost
 
-   I will compute PERFECT factor.
+/* Gain/offset of both channels: calib.c (runtime, EEPROM) */
 
-   Formula:
-       NEW = Multimeter_Voltage / ADC_RMS
------------------------------------------------------- */
-#define ZMPT_CALIBRATION       250.0f   // temporary placeholder
+/* Phase self-check: V-I angle in both modes under the same load */
+#define MAINS_PCHK_SETTLE      3        // cycles dropped after a switch
+#define MAINS_PCHK_CYCLES      25       // cycles averaged per mode
+#define MAINS_PCHK_MIN_VA      20.0f    // below this the angle is meaningless
+
+typedef enum {
+    MAINS_PCHK_NONE = 0,
+    MAINS_PCHK_RUNNING,
+    MAINS_PCHK_NO_LOAD,
+    MAINS_PCHK_DONE
+} MainsPhaseCheckState;
+
+typedef struct {
+    MainsPhaseCheckState state;
+    float seqDeg;           // acos(P/S), sequential sampling
+    float dualDeg;          // acos(P/S), simultaneous sampling
+    float expectedDeg;      // one-conversion skew at the measured frequency
+} MainsPhaseCheck;
+
+/* ------------- SIGNAL PATH BENCHMARK ---------------- */
+#define MAINS_BENCH_RUNS       8        // best-of, filters out IRQ hits
+
+typedef struct {
+    uint32_t floatCycPerSample;     // soft-float reference path
+    uint32_t fixedCycPerSample;     // integer path used by the engine
+} MainsBench;
 
 /* -------------------------------
  *  Function Prototypes
  * ------------------------------- */
-void ACS712_Init(ADC_HandleTypeDef *hadc);
+void ACS712_Init(void);                     // stream is started by ADC_Init
 void ACS712_Update(void);
+void ACS712_ProcessBlock(const AdcScanFrame *f, uint16_t n);   // adc_scan IRQ
 
 float ACS712_ReadCurrent(void);
 float ZMPT_ReadVoltageRMS(void);
+int32_t ACS712_GetZeroCounts(void);
+uint32_t ACS712_GetCycleSeq(void);          // newest published mains cycle
+float   ACS712_VoltsPerCount(void);
+float   ACS712_AmpsPerCount(void);
+
+void         ACS712_SetAcqMode(MainsAcqMode mode);
+MainsAcqMode ACS712_GetAcqMode(void);
+bool                   ACS712_StartPhaseCheck(void);
+const MainsPhaseCheck* ACS712_GetPhaseCheck(void);
+
+void ACS712_BenchSignalPath(MainsBench *out);   // CPU cycles per V/I pair
 
 #endif /* __ACS712_H__ */
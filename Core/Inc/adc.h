@@ -3,8 +3,10 @@
 
 #include "stm32f1xx_hal.h"
 #include <stdint.h>
+#include <stdbool.h>
 
-#define ADC_CHANNEL_COUNT 6
+#define ADC_CHANNEL_COUNT 6     // = ADC_SCAN_PROBES
+#define ADC_LEVEL_PROBES  5     // channels 1..5, channel 0 = dry run
 
 /* Struct to hold ADC readings */
 typedef struct {
@@ -13,9 +15,33 @@ typedef struct {
     uint8_t  maxReached[ADC_CHANNEL_COUNT];
 } ADC_Data;
 
+/* Water-level probe state (probes 1..ADC_LEVEL_PROBES) */
+typedef enum {
+    PROBE_UNKNOWN = 0,          // since boot, inside the hysteresis band
+    PROBE_WET,
+    PROBE_DRY
+} ProbeState;
+
+typedef enum {
+    PROBE_EVT_WET = 1,
+    PROBE_EVT_DRY
+} ProbeEventType;
+
+/* Edge of one probe, queued by ADC_ReadAllChannels */
+typedef struct {
+    uint8_t probe;              // 1..ADC_LEVEL_PROBES
+    uint8_t type;               // ProbeEventType
+} ProbeEvent;
+
 /* Public functions */
 void ADC_Init(ADC_HandleTypeDef* hadc);
-void ADC_ReadAllChannels(ADC_HandleTypeDef* hadc, ADC_Data* data);
+void ADC_ReadAllChannels(ADC_Data* data);
 uint8_t ADC_CheckMaxVoltage(ADC_Data* data, float threshold);
 
+uint16_t   ADC_GetFilteredCounts(uint8_t ch);   // median-filtered, unclamped
+bool       ADC_PeekProbeEvent(ProbeEvent *evt); // oldest, left queued
+bool       ADC_PopProbeEvent(ProbeEvent *evt);  // false when empty
+ProbeState ADC_GetProbeState(uint8_t probe);
+void       ADC_ReportProbeEvents(void);         // drain → LoRa packets
+
 #endif
@@ -0,0 +1,63 @@
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include "stm32f1xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   ADC SCAN SERVICE
+   - TIM3 TRGO (3.2 kHz) starts one hardware sequence of all
+     eight inputs; DMA1 Ch1 (circular) stores it as one
+     AdcScanFrame, one block of frames per half buffer
+   - acs712.c consumes the V/I pairs of every frame
+   - adc.c consumes one probe value per block (20 ms): the
+     mean of ADC_SCAN_PROBE_SUBBLOCKS sub-block means without
+     the highest and the lowest, so one splash or cable spike
+     up to a sub-block (2.5 ms) each way is rejected before it
+     reaches the level logic; adc.c's median of three blocks
+     takes out a whole bad cycle
+   No HAL_ADC_ConfigChannel/Start/Poll anywhere after start.
+   ============================================================ */
+
+#define ADC_SCAN_RANKS         8
+#define ADC_SCAN_PROBES        6        // ADC_CHANNEL_0 (dry run) .. _5
+#define ADC_SCAN_BLOCK_FRAMES  64       // frames per half buffer (one 50 Hz cycle)
+#define ADC_SCAN_PROBE_SUBBLOCKS  8     // probe burst: 8 means of 8 frames
+#define ADC_SCAN_RING_FRAMES   (2 * ADC_SCAN_BLOCK_FRAMES)  // whole DMA buffer
+
+/* Same halfword layout in both acquisition modes */
+typedef struct {
+    uint16_t v;                         // ZMPT101B, ADC_CHANNEL_6
+    uint16_t i;                         // ACS712,   ADC_CHANNEL_7
+    uint16_t probe[ADC_SCAN_PROBES];    // ADC_CHANNEL_0 .. ADC_CHANNEL_5
+} AdcScanFrame;
+
+typedef enum {
+    MAINS_ACQ_SEQUENTIAL = 0,   // ADC1 scans all 8 ranks (I one conversion after V)
+    MAINS_ACQ_DUAL              // ADC1 + ADC2 regular simultaneous, 4 ranks each
+} MainsAcqMode;
+
+#define MAINS_ACQ_DEFAULT      MAINS_ACQ_SEQUENTIAL
+
+/* Probe values (trimmed mean of sub-block means) of the newest block */
+typedef struct {
+    uint16_t probe[ADC_SCAN_PROBES];    // counts
+    uint32_t seq;                       // bumps once per block
+} AdcProbeScan;
+
+void         AdcScan_Init(ADC_HandleTypeDef *hadc);     // start in MAINS_ACQ_DEFAULT
+void         AdcScan_Start(MainsAcqMode mode);
+void         AdcScan_Stop(void);
+MainsAcqMode AdcScan_GetMode(void);
+
+void AdcScan_BlockReady(uint8_t half);                  // from ADC DMA callbacks
+
+bool                AdcScan_GetProbes(AdcProbeScan *out);   // false if no new block
+const AdcScanFrame* AdcScan_LastBlock(void);                // ADC_SCAN_BLOCK_FRAMES frames
+
+/* Live DMA ring, for IRQ-side look-back (fast-trip latency) */
+const AdcScanFrame* AdcScan_Ring(void);                     // ADC_SCAN_RING_FRAMES frames
+uint16_t            AdcScan_NewestIFrame(void);             // ring index, I sample written
+
+#endif /* ADC_SCAN_H */
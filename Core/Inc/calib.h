@@ -0,0 +1,56 @@
+#ifndef CALIB_H
+#define CALIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   MAINS V/I CALIBRATION
+   - per channel: value = gain * ADC RMS volts + offset
+   - stored in EEPROM (EE_ADDR_CALIB) with a check word,
+     defaults apply until a board has been calibrated
+   - @CAL:V:<volts># / @CAL:I:<amps>#: average the raw ADC RMS
+     over CALIB_CYCLES mains cycles against a reference meter
+       1st point : gain = (ref - offset) / raw   (ref 0: offset only)
+       2nd point : straight line through both points (same session,
+                   refs at least CALIB_MIN_SPAN apart)
+   ============================================================ */
+
+#define CALIB_CYCLES           50       // 1 s @ 50 Hz
+#define CALIB_DEFAULT_V_GAIN   239.5f   // ZMPT101B, bench-measured
+#define CALIB_DEFAULT_I_GAIN   (1.0f / 0.066f)   // ACS712-30A, 66 mV/A
+#define CALIB_MIN_SPAN         0.2f     // of the larger reference
+
+typedef enum {
+    CALIB_CH_V = 0,
+    CALIB_CH_I,
+    CALIB_CH_COUNT
+} CalibChannel;
+
+typedef struct {
+    float gain[CALIB_CH_COUNT];     // V or A per ADC RMS volt
+    float offset[CALIB_CH_COUNT];   // V or A
+} CalibFactors;
+
+typedef enum {
+    CALIB_IDLE = 0,
+    CALIB_RUNNING,
+    CALIB_DONE,
+    CALIB_FAILED                    // no signal on the channel
+} CalibState;
+
+void Calib_Init(void);                              // load from EEPROM
+const CalibFactors* Calib_Get(void);
+
+bool Calib_Start(CalibChannel ch, float reference); // false if busy
+void Calib_OnCycle(float rawV, float rawI);         // ADC RMS volts, per cycle
+CalibState Calib_GetState(void);
+void Calib_Reset(void);                             // defaults, saved
+
+static inline float Calib_Apply(const CalibFactors *c, CalibChannel ch, float raw)
+{
+    float v = raw * c->gain[ch] + c->offset[ch];
+    return (v > 0.0f) ? v : 0.0f;
+}
+
+#endif /* CALIB_H */
@@ -0,0 +1,57 @@
+#ifndef DRYPOWER_H
+#define DRYPOWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   SENSORLESS DRY-RUN (motor power signature)
+   - a centrifugal pump that loses its prime draws clearly less
+     active power, at a lower power factor
+   - baseline: mean P / PF over DRYPOWER_LEARN_CYCLES of normal
+     running (probe reports water, no load fault), learned once
+     per unit and kept in EEPROM (EE_ADDR_DRYPOWER)
+   - DRY  : P or PF < fracPct % of its baseline for nCycles
+            mains cycles
+     WET  : both at or above it for nCycles cycles
+     else UNKNOWN (motor off, start blanking, nothing learned)
+   - ModelHandle_CheckDryRun fuses it with the sump probe:
+     a confident verdict wins, UNKNOWN leaves the probe alone
+   ============================================================ */
+
+#define DRYPOWER_START_BLANK_MS   3000     // inrush + reprime after a start
+#define DRYPOWER_LEARN_CYCLES     250      // 5 s @ 50 Hz
+#define DRYPOWER_MIN_BASE_W       20.0f    // below this nothing is learned
+#define DRYPOWER_DEFAULT_FRAC     60       // % of baseline
+#define DRYPOWER_DEFAULT_CYCLES   100      // 2 s @ 50 Hz
+#define DRYPOWER_MAX_CYCLES       3000     // 60 s @ 50 Hz
+
+typedef enum {
+    DRYPOWER_UNKNOWN = 0,
+    DRYPOWER_WET,
+    DRYPOWER_DRY
+} DryPowerVerdict;
+
+typedef struct {
+    bool     learned;
+    bool     learning;
+    float    baseW;             // normal running active power
+    float    basePf;            // mean PF over the same cycles
+    uint8_t  fracPct;           // 0 = detector off
+    uint16_t nCycles;
+    float    lastW;             // last cycle while running
+    float    lastPf;
+    DryPowerVerdict verdict;
+} DryPowerStats;
+
+void DryPower_Init(void);                              // load from EEPROM
+void DryPower_OnCycle(float powerW, float apparentVA); // ACS712_Update
+DryPowerVerdict DryPower_GetVerdict(void);
+
+void DryPower_Learn(void);                  // relearn on the next good run
+void DryPower_SetThreshold(uint8_t fracPct, uint16_t nCycles);  // saved
+void DryPower_SetProbeWet(bool wet);        // probe state for learning
+
+const DryPowerStats* DryPower_GetStats(void);
+
+#endif /* DRYPOWER_H */
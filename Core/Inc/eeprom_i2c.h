@@ -2,6 +2,7 @@
 #define EEPROM_I2C_H
 
 #include "stm32f1xx_hal.h"
+#include <stdbool.h>
 #define EE_ADDR_GAP_TIME        0x00   // uint16
 #define EE_ADDR_RETRY_COUNT     0x02   // uint8
 #define EE_ADDR_UV_LIMIT        0x03   // uint16
@@ -12,9 +13,28 @@
 #define EE_ADDR_SIGNATURE       0x20   // uint16 (EEPROM valid marker)
 #define SETTINGS_SIGNATURE      0x55AA
 
+#define EE_ADDR_METER_RING      0x0400 // 8 x 8-byte slots, lifetime Wh (wear-levelled)
+#define EE_ADDR_CALIB           0x0440 // CalibFactors record (20 bytes), V/I gain + offset
+#define EE_ADDR_ZERO_OFFS       0x0460 // ZeroRecord (8 bytes), ZMPT/ACS712 zero counts
+#define EE_ADDR_DRYPOWER        0x0470 // DryPowerRecord (16 bytes), dry-run power baseline
+#define EE_ADDR_STARTPROF       0x0480 // StartProfRecord (20 bytes), motor start baseline
+#define EE_ADDR_LEVEL           0x04A0 // LevelRecord (28 bytes), level source + ladder bands
+#define EE_ADDR_PLEVEL          0x04C0 // PlevConfig record (16 bytes), pressure transducer + tank
+#define EE_ADDR_PQ_RING         0x0500 // 32 x 16-byte PqRecord, power-quality event log
+
 HAL_StatusTypeDef EEPROM_WriteByte(uint16_t addr, uint8_t data);
 HAL_StatusTypeDef EEPROM_ReadByte(uint16_t addr, uint8_t *data);
 HAL_StatusTypeDef EEPROM_WriteBuffer(uint16_t addr, uint8_t *buf, uint16_t len);
 HAL_StatusTypeDef EEPROM_ReadBuffer(uint16_t addr, uint8_t *buf, uint16_t len);
 
+/* Self-checked settings record: payload, then a uint16 signature
+   and a uint16 rotate-XOR check (seeded with the signature) over
+   payload + signature. Sizes above include those 4 bytes. One
+   page write, so payload + 4 must fit EE_RECORD_MAX and must not
+   cross a page at addr.                                        */
+#define EE_RECORD_MAX           32     // 24C32 page
+
+HAL_StatusTypeDef EEPROM_WriteRecord(uint16_t addr, const void *payload, uint16_t len, uint16_t sig);
+bool              EEPROM_ReadRecord(uint16_t addr, void *payload, uint16_t len, uint16_t sig);  // false: missing / corrupt
+
 #endif
@@ -0,0 +1,63 @@
+#ifndef FASTTRIP_H
+#define FASTTRIP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   OVERCURRENT FAST-TRIP (ADC analog watchdog)
+   - AWD in single-channel mode on the ACS712 rank
+     (ADC1 sequential, ADC2 in dual mode)
+   - window = zero offset ± sys.overload * mult as a peak
+     (x sqrt2), so only a locked-rotor class current trips it;
+     slower faults stay with ModelHandle_CheckLoadFault
+   - mult is FASTTRIP_LR_MULT when that peak fits between the
+     zero offset and the ADC rails (1..4094), else the largest
+     multiple that fits, but never below FASTTRIP_LR_MULT_MIN;
+     below that the window is clamped to the rails and the trip
+     only sees a saturated sensor (stats: clamped)
+   - effective trip current (RMS) = min(sys.overload * mult,
+     headroom x AmpsPerCount / sqrt2); ACS712-30A at the default
+     gain with the zero at mid-scale: headroom 2046 counts =
+     25 A peak = 17.7 A RMS, so x4 up to 4.4 A overload, x2..x4
+     up to 8.8 A, clamped at 17.7 A above that
+   - the AWD IRQ drops Relay 1 itself, then flags the model FSM
+   - armed only while the motor runs, after the start inrush
+   - ADC1_2 is the only IRQ at preemption priority 0, so no ISR
+     (the DMA block ISR included) can hold the relay-off back
+   - latency: end of the tripping I conversion to relay-off, in
+     CPU cycles. The newest I sample is timed from TIM3 CNT, then
+     the DMA ring is walked back to the first sample of the
+     out-of-window run, one TIM3 period per frame. A trip older
+     than the ring (40 ms) reads FASTTRIP_LAT_OVERFLOW instead
+     of aliasing to a short figure
+   ============================================================ */
+
+#define FASTTRIP_ENABLED_DEFAULT   1
+#define FASTTRIP_LR_MULT           4.0f    // x sys.overload (RMS), preferred
+#define FASTTRIP_LR_MULT_MIN       2.0f    // lowest multiple before clamping
+#define FASTTRIP_START_BLANK_MS    1000    // inrush window after a start
+#define FASTTRIP_LAT_OVERFLOW      0xFFFFFFFFUL    // latency past the ring
+
+typedef struct {
+    bool     enabled;
+    bool     armed;
+    uint16_t highCounts;        // AWD window programmed in the ADC
+    uint16_t lowCounts;
+    float    tripA;             // effective trip current (RMS) of the window
+    float    mult;              // x sys.overload actually used
+    bool     clamped;           // window hit the ADC rails
+    uint32_t trips;
+    uint32_t lastLatencyCyc;    // relay-off - end of tripping conversion,
+                                // FASTTRIP_LAT_OVERFLOW if not resolvable
+    uint32_t worstLatencyCyc;
+} FastTripStats;
+
+void FastTrip_Task(void);           // arm/disarm + thresholds, protect task
+void FastTrip_IRQHandler(void);     // from ADC1_2_IRQHandler, before HAL
+bool FastTrip_TakeTrip(void);       // true once per trip (model FSM)
+
+void                 FastTrip_SetEnabled(bool on);
+const FastTripStats* FastTrip_GetStats(void);
+
+#endif /* FASTTRIP_H */
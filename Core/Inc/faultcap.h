@@ -0,0 +1,76 @@
+#ifndef FAULTCAP_H
+#define FAULTCAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "adc_scan.h"
+
+/* ============================================================
+   FAULT WAVEFORM CAPTURE
+   - raw V/I pairs of the last FAULTCAP_CYCLES mains cycles,
+     int16 (counts - 2048), written from the adc_scan IRQ
+   - trigger from the load/volt FSM (WAIT or LOCK); recording
+     continues FAULTCAP_POST_CYCLES, then the ring freezes
+   - @CAP:DUMP# streams it as binary frames, one per UART
+     task pass, so the loop is never blocked for long:
+
+       0xA5 0x5A | type | index | len | payload[len] | fletcher16
+       (fletcher16 over type..payload, little endian)
+
+       type 1 HEADER  : FaultCapHeader
+       type 2 SAMPLES : FAULTCAP_FRAME_PAIRS x { int16 v, int16 i }
+       type 3 END     : no payload
+   ============================================================ */
+
+#define FAULTCAP_CYCLES        8
+#define FAULTCAP_POST_CYCLES   2        // pre-trigger = CYCLES - POST
+#define FAULTCAP_FRAME_PAIRS   16       // 64 B payload, ~6 ms @ 115200
+
+#define FAULTCAP_SYNC0         0xA5
+#define FAULTCAP_SYNC1         0x5A
+
+typedef enum {
+    FAULTCAP_FRAME_HEADER  = 1,
+    FAULTCAP_FRAME_SAMPLES = 2,
+    FAULTCAP_FRAME_END     = 3
+} FaultCapFrameType;
+
+/* what the FSM was doing when it fired */
+typedef enum {
+    FAULTCAP_STAGE_WAIT = 1,            // LOAD_FAULT_WAIT entered
+    FAULTCAP_STAGE_LOCK = 2             // LOAD_FAULT_LOCK entered
+} FaultCapStage;
+
+#define FAULTCAP_CAUSE_OVERLOAD   0x01
+#define FAULTCAP_CAUSE_UNDERLOAD  0x02
+#define FAULTCAP_CAUSE_VOLT       0x04
+#define FAULTCAP_CAUSE_FASTTRIP   0x08
+
+typedef enum {
+    FAULTCAP_ARMED = 0,                 // recording, waiting for a trigger
+    FAULTCAP_POST,                      // triggered, recording post-trigger
+    FAULTCAP_FROZEN                     // complete, ready to dump
+} FaultCapState;
+
+typedef struct __attribute__((packed)) {
+    uint8_t  stage;                     // FaultCapStage
+    uint8_t  cause;                     // FAULTCAP_CAUSE_* bits
+    uint16_t pairs;                     // samples in the dump
+    uint16_t triggerIndex;              // pair index of the trigger
+    uint16_t sampleRateHz;
+    float    voltsPerCount;             // mains V per count (calibrated)
+    float    ampsPerCount;              // A per count
+    float    vRms;                      // values at the trigger
+    float    iRms;
+    uint32_t ageMs;                     // trigger -> dump start
+} FaultCapHeader;
+
+void FaultCap_Block(const AdcScanFrame *f, uint16_t n); // adc_scan IRQ
+void FaultCap_Trigger(FaultCapStage stage, uint8_t cause);
+void FaultCap_Arm(void);
+bool FaultCap_StartDump(void);          // false unless frozen
+void FaultCap_Task(void);               // sends one frame while dumping
+
+FaultCapState FaultCap_GetState(void);
+
+#endif /* FAULTCAP_H */
@@ -0,0 +1,115 @@
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#include <stdint.h>
+
+/* ============================================================
+   INTEGER HELPERS FOR THE SIGNAL PATH (Cortex-M3, no FPU)
+   - isqrt32/isqrt64 : floor(sqrt(x)), bit-by-bit, no division
+   - cycle_rms_q8    : AC RMS of one cycle's sums, Q8 counts
+   - ema_q4_step     : y += (x - y) * alpha, alpha in Q8,
+                       state kept in 1/16 count (Q4) so small
+                       steps are not lost to truncation
+   - median3_u16     : branch-only median of three
+   - median_u16      : in-place insertion sort, middle value
+                       (mean of the two middles for even n)
+   - trim_mean_u16   : mean without the largest and smallest,
+                       one pass, no sort (probe sub-blocks)
+   Floats only appear where values leave the pipeline.
+   ============================================================ */
+
+#define FIX_EMA_FRAC_BITS    4
+#define FIX_ALPHA_Q8(a)      ((int32_t)((a) * 256.0f + 0.5f))   // compile-time
+
+static inline uint32_t isqrt32(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > x) bit >>= 2;
+
+    while (bit)
+    {
+        if (x >= res + bit) { x -= res + bit; res = (res >> 1) + bit; }
+        else                {                 res >>= 1;              }
+        bit >>= 2;
+    }
+    return res;
+}
+
+static inline uint32_t isqrt64(uint64_t x)
+{
+    if (x <= UINT32_MAX)
+        return isqrt32((uint32_t)x);
+
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > x) bit >>= 2;
+
+    while (bit)
+    {
+        if (x >= res + bit) { x -= res + bit; res = (res >> 1) + bit; }
+        else                {                 res >>= 1;              }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+/* RMS of one channel over the cycle in Q8 counts: integer sqrt of the
+   integer variance about the cycle mean (the DC offset drops out).
+   n*sq - sum^2 = n^2 * var; << 16 before the root gives Q8.        */
+static inline uint32_t cycle_rms_q8(uint32_t sum, uint64_t sq, uint16_t n)
+{
+    uint64_t var = (uint64_t)n * sq - (uint64_t)sum * sum;
+    return isqrt64(var << 16) / n;
+}
+
+/* state: Q4 counts, x: raw counts, alpha: FIX_ALPHA_Q8(...) */
+static inline int32_t ema_q4_step(int32_t state, int32_t x, int32_t alpha_q8)
+{
+    int32_t target = x << FIX_EMA_FRAC_BITS;
+    return state + (((target - state) * alpha_q8) >> 8);
+}
+
+static inline uint16_t median3_u16(uint16_t a, uint16_t b, uint16_t c)
+{
+    if (a > b) { uint16_t t = a; a = b; b = t; }
+    if (b > c) b = c;
+    return (a > b) ? a : b;
+}
+
+/* small n only (probe sub-blocks): sorts v[] in place */
+static inline uint16_t median_u16(uint16_t *v, uint8_t n)
+{
+    for (uint8_t i = 1; i < n; i++)
+    {
+        uint16_t x = v[i];
+        uint8_t  j = i;
+        while (j && v[j - 1] > x) { v[j] = v[j - 1]; j--; }
+        v[j] = x;
+    }
+
+    if (n & 1)
+        return v[n / 2];
+    return (uint16_t)(((uint32_t)v[n / 2 - 1] + v[n / 2] + 1U) >> 1);
+}
+
+/* n > 2; one outlier on each side drops out, the rest is averaged */
+static inline uint16_t trim_mean_u16(const uint16_t *v, uint8_t n)
+{
+    uint32_t sum = v[0];
+    uint16_t lo  = v[0], hi = v[0];
+
+    for (uint8_t i = 1; i < n; i++)
+    {
+        sum += v[i];
+        if (v[i] < lo) lo = v[i];
+        if (v[i] > hi) hi = v[i];
+    }
+
+    sum -= (uint32_t)lo + hi;
+    return (uint16_t)((sum + (n - 2U) / 2U) / (n - 2U));
+}
+
+#endif /* FIXMATH_H */
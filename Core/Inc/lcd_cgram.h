@@ -0,0 +1,72 @@
+#ifndef LCD_CGRAM_H
+#define LCD_CGRAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   CGRAM GLYPH CACHE
+   - owns the 8 HD44780 custom-character slots
+   - lcd_cgram_get() returns the character code of a resident
+     glyph, loading it into a free / least recently used slot
+     when needed; the upload itself goes out with the next
+     lcd_fb_flush(), ahead of the DDRAM writes
+   - codes are 0x08..0x0F (same CGRAM as 0x00..0x07, but no
+     NUL in the framebuffer strings)
+   - a slot is never evicted while its code is still in the
+     framebuffer or was handed out since the last flush; if
+     all 8 are pinned, get() returns the glyph's ASCII fallback
+   - at most LCD_CGRAM_MAX_UPLOADS go out per flush; a cell
+     whose glyph is still queued shows the ASCII fallback
+     until its upload has been sent (lcd_cgram_stand_in), so
+     the glass never shows stale or unwritten CGRAM
+   - a dashboard that keeps showing the same glyphs costs no
+     CGRAM traffic at all after the first frame
+   ============================================================ */
+
+#define LCD_CGRAM_SLOTS        8
+#define LCD_CGRAM_MAX_UPLOADS  3        // per flush, keeps LCD_ASYNC_BUF bounded
+
+typedef enum {
+    GLYPH_TANK_0 = 0,                   // tank outline, 0..6 rows of water
+    GLYPH_TANK_1,
+    GLYPH_TANK_2,
+    GLYPH_TANK_3,
+    GLYPH_TANK_4,
+    GLYPH_TANK_5,
+    GLYPH_TANK_6,
+    GLYPH_BAR_1,                        // bar graph cell, 1..4 of 5 columns
+    GLYPH_BAR_2,                        // (5 of 5 is the ROM block 0xFF)
+    GLYPH_BAR_3,
+    GLYPH_BAR_4,
+    GLYPH_PUMP_ON,
+    GLYPH_PUMP_OFF,
+    GLYPH_BELL,
+    GLYPH_SIG_0,                        // no link
+    GLYPH_SIG_1,
+    GLYPH_SIG_2,
+    GLYPH_SIG_3,
+    GLYPH_COUNT
+} LcdGlyph;
+
+#define LCD_GLYPH_TANK_LEVELS  7
+#define LCD_GLYPH_BLOCK        ((char)0xFF)
+
+typedef struct {
+    uint32_t hits;                      // already resident
+    uint32_t uploads;                   // CGRAM writes sent
+    uint32_t fallbacks;                 // all slots pinned
+} LcdCgramStats;
+
+void lcd_cgram_init(void);              // CGRAM content unknown, all slots free
+void lcd_cgram_invalidate(void);        // re-upload every resident glyph
+char lcd_cgram_get(LcdGlyph g);
+
+/* lcd_fb_flush only: queue pending uploads into the async buffer,
+   then map each cell through stand_in (fallback while queued) */
+void lcd_cgram_emit(void);
+char lcd_cgram_stand_in(char c);
+
+const LcdCgramStats* lcd_cgram_stats(void);
+
+#endif /* LCD_CGRAM_H */
@@ -0,0 +1,43 @@
+#ifndef LCD_FB_H
+#define LCD_FB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   2x16 SHADOW FRAMEBUFFER
+   - screen code writes characters into RAM only
+   - lcd_fb_flush() compares with what is on the glass and
+     sends a cursor move + the dirty run, nothing else
+   - runs separated by a single clean cell are merged (one
+     data byte is cheaper than a cursor command)
+   - lcd_fb_invalidate() after anything that changes the glass
+     behind our back (lcd_init, lcd_clear)
+   - sent with the async I2C transport: never blocks, skipped
+     while the previous flush is still on the bus
+   - pending CGRAM glyph uploads (lcd_cgram.h) go first in
+     the same transfer
+   ============================================================ */
+
+#define LCD_FB_ROWS   2
+#define LCD_FB_COLS   16
+
+typedef struct {
+    uint32_t flushes;
+    uint32_t charsSent;         // data bytes, lifetime
+    uint32_t cursorMoves;
+    uint32_t skipped;           // transport still busy
+    uint16_t lastChars;         // bytes of the last flush
+} LcdFbStats;
+
+void lcd_fb_init(void);                                 // glass assumed clear
+void lcd_fb_clear(void);                                // RAM only
+void lcd_fb_line(uint8_t row, const char *s);           // padded / cut to 16
+void lcd_fb_putc(uint8_t row, uint8_t col, char c);
+bool lcd_fb_contains(char c);                           // for the CGRAM cache
+void lcd_fb_invalidate(void);                           // full redraw next flush
+uint16_t lcd_fb_flush(void);                            // returns bytes sent
+
+const LcdFbStats* lcd_fb_stats(void);
+
+#endif /* LCD_FB_H */
@@ -2,6 +2,7 @@
 #define LCD_I2C_H
 
 #include "main.h"
+#include <stdbool.h>
 
 /* 8-bit I2C address for HAL (7-bit << 1):
    0x27 (7-bit) -> 0x4E (8-bit), 0x3F (7-bit) -> 0x7E (8-bit) */
@@ -17,6 +18,42 @@
 #define LCD_PINMAP LCD_PINMAP_A   // try A first; if no text, switch to B and rebuild
 #endif
 
+/* ============================================================
+   ASYNC TRANSPORT
+   - begin / cmd / data / put_cur / string fill one buffer
+     (4 expander bytes per LCD byte), commit hands it to
+     I2C2 TX DMA and returns at once
+   - clear/home split the buffer; the 2 ms they need is
+     counted down in SysTick, never waited for in the loop
+   - begin fails while a transfer is still running; EEPROM
+     and RTC share I2C2 and call lcd_async_wait_idle first
+   - a bus error drops the rest of the update and is latched
+     for lcd_async_take_error() (caller redraws everything)
+   ============================================================ */
+
+#define LCD_ASYNC_BUF         256     // full 2x16 redraw 140 + 3 CGRAM glyphs 114
+#define LCD_ASYNC_SEGS        4
+#define LCD_ASYNC_SLOW_MS     2       // clear / home: 1.52 ms
+#define LCD_ASYNC_TIMEOUT_MS  30      // worst full buffer is ~18 ms @ 100 kHz
+
+typedef struct {
+    uint32_t commits;
+    uint32_t bytes;             // expander bytes, lifetime
+    uint16_t lastBytes;
+    uint16_t errors;            // bus errors + timeouts
+    uint16_t overflows;         // update did not fit LCD_ASYNC_BUF
+} LcdAsyncStats;
+
+/* lcd_bench_string: the same string through the old per-nibble
+   path and the burst path, on row 2 (redraw afterwards).
+   Blocks for ~11 ms per character on the old path.           */
+typedef struct {
+    uint32_t oldBytes;          // I2C bytes incl. address phases
+    uint32_t oldUs;
+    uint32_t newBytes;
+    uint32_t newUs;
+} LcdBench;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,6 +67,19 @@ void lcd_send_string(char *str);
 void lcd_backlight_on(void);
 void lcd_backlight_off(void);
 void lcd_self_test(void);
+void lcd_bench_string(const char *str, LcdBench *out);
+
+bool lcd_async_begin(void);                     // false while busy
+void lcd_async_cmd(uint8_t cmd);
+void lcd_async_data(uint8_t data);
+void lcd_async_put_cur(uint8_t row, uint8_t col);
+void lcd_async_string(const char *str);
+bool lcd_async_commit(void);                    // false on overflow / start error
+bool lcd_async_busy(void);
+bool lcd_async_wait_idle(uint32_t timeoutMs);   // false on timeout (aborted)
+bool lcd_async_take_error(void);
+void lcd_async_tick(void);                      // SysTick
+const LcdAsyncStats* lcd_async_stats(void);
 
 #ifdef __cplusplus
 }
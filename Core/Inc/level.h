@@ -0,0 +1,68 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   TANK LEVEL SOURCE
+   - one answer for the dashboard, the status packet and the
+     tank-full logic: "k of N steps submerged"
+   - PROBES : one ADC input per probe (channels 1..5),
+              submerged = filtered probe < LEVEL_PROBE_WET_V
+   - LADDER : N probes on one resistor ladder at
+              LEVEL_LADDER_PROBE; each submerged probe moves the
+              node into the next voltage band. Band centres are
+              calibrated per k (@LEVEL:CAL:<k>#), boundaries are
+              the midpoints, and a reading must cross a boundary
+              by `hyst` counts for LEVEL_LADDER_DWELL cycles.
+              Frees ADC_CHANNEL_2..5 for other sensors.
+   - PRESSURE : continuous level from a transducer
+              (pressure_level.c); mm + % directly, submerged
+              steps are derived (% x LEVEL_PROBE_STEPS / 100)
+              so the status packet keeps its 0..5 range
+   - source, N, centres and hysteresis live in EEPROM
+     (EE_ADDR_LEVEL)
+   ============================================================ */
+
+#define LEVEL_PROBE_STEPS      5
+#define LEVEL_PROBE_WET_V      0.1f     // probe shorted by water
+#define LEVEL_LADDER_PROBE     1        // adcData index = ADC_CHANNEL_1
+#define LEVEL_LADDER_MAX       8        // probes on one ladder
+#define LEVEL_LADDER_HYST      40       // counts (~32 mV)
+#define LEVEL_LADDER_DWELL     3        // cycles (20 ms)
+
+typedef enum {
+    LEVEL_SRC_PROBES = 0,
+    LEVEL_SRC_LADDER,
+    LEVEL_SRC_PRESSURE
+} LevelSource;
+
+typedef struct {
+    uint8_t  steps;                             // N probes on the ladder
+    uint16_t hyst;                              // counts
+    uint16_t center[LEVEL_LADDER_MAX + 1];      // counts for 0..N submerged
+} LevelLadderCfg;
+
+void        Level_Init(void);                   // load from EEPROM
+void        Level_Update(void);                 // after ADC_ReadAllChannels
+
+LevelSource Level_GetSource(void);
+uint8_t     Level_GetSubmerged(void);           // 0..Level_GetSteps()
+uint8_t     Level_GetSteps(void);
+uint8_t     Level_GetPercent(void);
+bool        Level_IsFull(void);               // true on a level fault too
+bool        Level_IsFault(void);              // transducer open / broken wire
+bool        Level_IsContinuous(void);           // mm available
+uint16_t    Level_GetMm(void);                  // 0 unless continuous
+
+/* configuration (each call is saved) */
+void        Level_SetSource(LevelSource src);
+bool        Level_SetLadderSteps(uint8_t steps);
+bool        Level_CalibrateBand(uint8_t k);     // centre[k] = current reading
+void        Level_SetHysteresis(uint16_t counts);
+
+const LevelLadderCfg* Level_GetLadder(void);
+uint16_t    Level_GetLadderRaw(void);           // filtered, unclamped counts
+
+#endif /* LEVEL_H */
@@ -42,4 +42,8 @@ uint8_t LoRa_ReceivePacket(uint8_t *buffer, int16_t *rssi);
 
 void LoRa_Task(void);
 
+/* 0 = no packet for LORA_LINK_STALE_MS, 1..3 = RSSI bands */
+#define LORA_LINK_STALE_MS   60000
+uint8_t LoRa_GetLinkBars(void);
+
 #endif /* __LORA_H__ */
@@ -0,0 +1,35 @@
+#ifndef METER_H
+#define METER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   ENERGY METER
+   - active power from acs712.c (mean of v*i per mains cycle)
+   - apparent power = Vrms * Irms, PF = P / S
+   - Wh counters: current/last run, today (RTC date), lifetime
+   - lifetime is kept in an 8-slot EEPROM ring, written only
+     every METER_SAVE_STEP_WH or when a run ends
+   ============================================================ */
+
+#define METER_MIN_W            5.0f    // below this P is treated as 0 (noise)
+#define METER_SAVE_STEP_WH     50      // lifetime EEPROM write granularity
+#define METER_RING_SLOTS       8
+
+typedef struct {
+    float    activeW;
+    float    apparentVA;
+    float    pf;            // 0..1
+    uint32_t runWh;         // current run (or last run while motor is off)
+    uint32_t dayWh;         // since midnight (RTC)
+    uint32_t lifeWh;        // persisted
+} MeterReadings;
+
+void Meter_Init(void);      // load lifetime Wh from EEPROM
+void Meter_Task(void);      // call after ACS712_Update()
+void Meter_Flush(void);     // force lifetime save if changed
+
+const MeterReadings* Meter_Get(void);
+
+#endif /* METER_H */
@@ -68,6 +68,7 @@ extern volatile bool senseDryRun;
 extern volatile bool senseOverLoad;
 extern volatile bool senseOverUnderVolt;
 extern volatile bool senseMaxRunReached;
+extern volatile bool senseLevelFault;     // level sensor dead, tank reads full
 extern volatile bool manualOverride;
 
 /* ============================================================
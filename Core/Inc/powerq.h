@@ -0,0 +1,81 @@
+#ifndef POWERQ_H
+#define POWERQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   POWER-QUALITY MONITOR
+   - fed with every mains cycle's RMS voltage and frequency
+     (ACS712_Update); cycles the task missed are counted from
+     the engine sequence, so durations stay cycle-accurate
+   - SAG   : V < PQ_SAG_PCT of PQ_NOMINAL_V, ends above +hyst
+     SWELL : V > PQ_SWELL_PCT, ends below -hyst
+     INTERRUPTION : a sag that went under PQ_INTERRUPT_PCT
+     FREQ  : |f - PQ_NOMINAL_HZ| > PQ_FREQ_DEV_HZ for at least
+             PQ_FREQ_MIN_CYCLES
+     POWERUP : boot (the supply was lost long enough to reset)
+   - each event: RTC start stamp, duration, extreme value
+     (min V / max V / farthest Hz), appended to a wear-levelled
+     EEPROM ring (EE_ADDR_PQ_RING) from the UART task, so the
+     cycle path never waits on I2C
+   - @PQ:LOG# reads it back one record per UART pass
+   - @PQ:CLEAR# zeroes the ring one slot per UART pass too; the
+     counters and ring head only reset after all 32 writes succeed
+   ============================================================ */
+
+#define PQ_NOMINAL_V          230.0f
+#define PQ_NOMINAL_HZ         50.0f
+#define PQ_SAG_PCT            90
+#define PQ_SWELL_PCT          110
+#define PQ_INTERRUPT_PCT      10
+#define PQ_HYST_PCT           2
+#define PQ_FREQ_DEV_HZ        1.0f
+#define PQ_FREQ_MIN_CYCLES    10
+#define PQ_RING_SLOTS         32        // 16 B each
+
+typedef enum {
+    PQ_EVT_SAG = 1,
+    PQ_EVT_SWELL,
+    PQ_EVT_INTERRUPTION,
+    PQ_EVT_FREQ,
+    PQ_EVT_POWERUP
+} PqEventType;
+
+typedef struct {
+    uint32_t stamp;             // PQ_STAMP(...) packed RTC time
+    uint16_t cycles;            // duration, mains cycles (saturates)
+    uint16_t extreme;           // V x10 (sag/swell/int), Hz x100 (freq)
+    uint8_t  type;              // PqEventType
+    uint8_t  reserved;
+    uint16_t seq;
+    uint16_t check;
+    uint16_t pad;
+} PqRecord;
+
+/* yy(6) mm(4) dd(5) hh(5) mi(6) ss(6), yy from 2000 */
+#define PQ_STAMP_YY(s)   (((s) >> 26) & 0x3F)
+#define PQ_STAMP_MM(s)   (((s) >> 22) & 0x0F)
+#define PQ_STAMP_DD(s)   (((s) >> 17) & 0x1F)
+#define PQ_STAMP_HH(s)   (((s) >> 12) & 0x1F)
+#define PQ_STAMP_MI(s)   (((s) >>  6) & 0x3F)
+#define PQ_STAMP_SS(s)   ((s) & 0x3F)
+
+typedef struct {
+    float    hzAvg;             // mean of the last second
+    float    hzMin, hzMax;      // since clear
+    float    vMin, vMax;
+    uint16_t count[PQ_EVT_POWERUP + 1];     // per PqEventType
+    uint32_t cycles;            // cycles seen
+    uint32_t lost;              // published by the engine, not seen here
+} PqStats;
+
+void PowerQ_Init(void);                 // find the ring head, log POWERUP
+void PowerQ_OnCycle(float vRms, float hz, uint32_t seq);
+void PowerQ_Task(void);                 // EEPROM writes + log dump, UART task
+
+bool PowerQ_StartDump(void);            // false if the log is empty
+void PowerQ_Clear(void);                // async, see PowerQ_Task
+const PqStats* PowerQ_GetStats(void);
+
+#endif /* POWERQ_H */
@@ -0,0 +1,74 @@
+#ifndef PRESSURE_LEVEL_H
+#define PRESSURE_LEVEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   CONTINUOUS LEVEL – analog pressure transducer
+   - one spare probe input (adcData index 1..5) carries either
+       0.5–4.5 V ratiometric sensor through a 2:3 divider, or
+       4–20 mA loop over a 150 R shunt
+   - head mm = (counts - zero) * fsMm / span  (+ sensor height)
+   - integer EMA on the median-filtered counts (alpha 1/32,
+     ~0.6 s) rides out surface ripple while filling
+   - tank geometry: full level (or diameter) in mm, vertical
+     tank = linear %, horizontal cylinder = volume % (table)
+   - below zero - PLEV_FAULT_COUNTS (open loop, broken wire)
+     the reading is invalid: PLevel_IsFull() answers true so
+     the pump stops / will not start, and the model raises
+     senseLevelFault (bell, buzzer, red LED)
+   - config in EEPROM (EE_ADDR_PLEVEL)
+   ============================================================ */
+
+#define PLEV_DEFAULT_PROBE     2        // ADC_CHANNEL_2, free in ladder mode
+#define PLEV_EMA_SHIFT         5
+#define PLEV_FAULT_COUNTS      150      // ~0.12 V under the zero point
+#define PLEV_FULL_HYST_MM      20
+
+/* front-end presets (counts @ 3.3 V / 4095) */
+#define PLEV_V05_ZERO          413      // 0.5 V x 2/3
+#define PLEV_V05_SPAN          3310     // 4.0 V x 2/3
+#define PLEV_MA420_ZERO        745      // 4 mA x 150 R
+#define PLEV_MA420_SPAN        2978     // 16 mA x 150 R
+#define PLEV_DEFAULT_FS_MM     5000     // 0–0.5 bar sensor ≈ 5 m H2O
+
+typedef enum {
+    PLEV_TANK_VERTICAL = 0,             // % of fullMm
+    PLEV_TANK_HORIZONTAL                // fullMm = diameter, % of volume
+} PlevTankShape;
+
+typedef enum {
+    PLEV_PRESET_V05 = 0,
+    PLEV_PRESET_MA420
+} PlevPreset;
+
+typedef struct {
+    uint8_t  probe;             // adcData index of the sensor
+    uint8_t  shape;             // PlevTankShape
+    uint16_t zeroCounts;        // sensor output at 0 head
+    uint16_t spanCounts;        // zero -> full scale
+    uint16_t fsMm;              // full scale, mm of water
+    uint16_t sensorMm;          // sensor height above the tank bottom
+    uint16_t fullMm;            // 100 % level (vertical) / diameter
+} PlevConfig;
+
+void PLevel_Init(void);                 // load from EEPROM
+void PLevel_Update(void);               // reads ADC_GetFilteredCounts
+void PLevel_Feed(uint16_t counts);      // one filtered sample (any source)
+
+bool     PLevel_IsValid(void);
+uint16_t PLevel_GetMm(void);            // water level above the bottom
+uint8_t  PLevel_GetPercent(void);
+bool     PLevel_IsFull(void);             // also true while invalid
+uint16_t PLevel_GetFaultCount(void);     // valid -> invalid transitions
+uint16_t PLevel_GetRaw(void);           // last input counts
+
+/* configuration (each call is saved) */
+const PlevConfig* PLevel_GetConfig(void);
+void PLevel_ApplyPreset(PlevPreset p, uint16_t fsMm);
+void PLevel_CaptureZero(void);          // sensor in air / empty tank
+bool PLevel_SetTank(uint16_t fullMm, uint16_t sensorMm, PlevTankShape shape);
+bool PLevel_SetProbe(uint8_t probe);
+
+#endif /* PRESSURE_LEVEL_H */
@@ -0,0 +1,66 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   STAGE PROFILER (Cortex-M3 DWT CYCCNT)
+   - One slot per main-loop stage, plus the ADC DMA block ISR
+     and its probe decimation (stage ends in IRQ context)
+   - min / max / mean in CPU cycles
+   - log2 histogram in microseconds:
+       bin 0      : < 2 us
+       bin k      : [2^k, 2^(k+1)) us
+       last bin   : everything above
+   ============================================================ */
+
+typedef enum {
+    PROF_ACS712_UPDATE = 0,
+    PROF_ADC_READ,
+    PROF_SWITCHES,
+    PROF_SCREEN_UPDATE,
+    PROF_RTC_READ,
+    PROF_MODEL_PROCESS,
+    PROF_DRYRUN_PROCESS,
+    PROF_LORA_TASK,
+    PROF_LED_TASK,
+    PROF_ADC_BLOCK,                 // whole AdcScan_BlockReady (DMA ISR)
+    PROF_PROBE_DECIM,               // its probe sub-block decimation
+    PROF_STAGE_COUNT
+} ProfStage;
+
+#define PROF_HIST_BINS      16      // last bin = >= 32.768 ms
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_cyc;
+    uint32_t max_cyc;
+    uint64_t sum_cyc;
+    uint16_t hist[PROF_HIST_BINS];  // saturating counters
+} ProfStats;
+
+void Prof_Init(void);               // enable trace + CYCCNT
+void Prof_Reset(void);
+
+static inline uint32_t Prof_Begin(void)
+{
+    return DWT->CYCCNT;
+}
+
+void Prof_End(ProfStage stage, uint32_t start_cyc);
+
+const ProfStats* Prof_GetStats(ProfStage stage);
+const char*      Prof_StageName(ProfStage stage);
+uint32_t         Prof_CyclesToUs(uint32_t cycles);
+
+/* Wrap one call: PROF_RUN(PROF_LED_TASK, LED_Task()); */
+#define PROF_RUN(stage, call)                   \
+    do {                                        \
+        uint32_t _prof_t0 = Prof_Begin();       \
+        call;                                   \
+        Prof_End((stage), _prof_t0);            \
+    } while (0)
+
+#endif /* PROFILER_H */
@@ -0,0 +1,42 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   COOPERATIVE DEADLINE SCHEDULER
+   - Static task table (lives in flash, owned by main.c)
+   - Each task: period, relative deadline, priority (0 = highest)
+   - Idle time is spent in WFI (woken by SysTick / IRQs)
+   ============================================================ */
+
+#define SCHED_MAX_TASKS     12
+
+typedef void (*SchedTaskFn)(void);
+
+typedef struct {
+    const char *name;        // short tag for UART reports
+    SchedTaskFn fn;
+    uint16_t    period_ms;   // release interval
+    uint16_t    deadline_ms; // release -> completion budget
+    uint8_t     priority;    // 0 = highest
+} SchedTask;
+
+typedef struct {
+    uint32_t runs;
+    uint32_t overruns;       // completed later than deadline_ms after release
+    uint32_t skipped;        // whole periods lost because the task started late
+    uint16_t worst_ms;       // worst release -> completion latency seen
+    uint16_t last_ms;
+} SchedTaskStats;
+
+void    Scheduler_Init(const SchedTask *table, uint8_t count);
+void    Scheduler_RunOnce(void);       // run one ready task, or WFI if none
+void    Scheduler_ResetStats(void);
+
+uint8_t               Scheduler_GetTaskCount(void);
+const SchedTask*      Scheduler_GetTask(uint8_t idx);
+const SchedTaskStats* Scheduler_GetStats(uint8_t idx);
+
+#endif /* SCHEDULER_H */
@@ -0,0 +1,21 @@
+#ifndef SIGBENCH_H
+#define SIGBENCH_H
+
+#include <stdint.h>
+#include "adc_scan.h"
+
+/* ============================================================
+   SIGNAL PATH BENCHMARK KERNELS (float vs fixed)
+   - FLOAT: the old per-sample path – volts conversion, float
+            sums of squares and v*i, float EMA, sqrtf per cycle
+   - FIXED: what the engine does now – integer sums, isqrt64,
+            Q4 shift EMA, volts only at the end
+   - no HAL calls: timed on target by ACS712_BenchSignalPath
+     (@PROF:BENCH#, DWT cycles) and on the build machine by
+     Tests/host/test_signal_path (ns, plus accuracy checks)
+   ============================================================ */
+
+void SigBench_Float(const AdcScanFrame *p, uint16_t n);
+void SigBench_Fixed(const AdcScanFrame *p, uint16_t n);
+
+#endif /* SIGBENCH_H */
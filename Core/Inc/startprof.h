@@ -0,0 +1,73 @@
+#ifndef STARTPROF_H
+#define STARTPROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================
+   MOTOR START PROFILING
+   - every motor_apply(true) opens a STARTPROF_WINDOW_CYCLES
+     window of per-cycle RMS current / active power
+   - per start: peak cycle current, time until the current stays
+     within STARTPROF_SETTLE_PCT of steady state, steady power
+     (mean of the last STARTPROF_STEADY_CYCLES of the window)
+   - a motor stopped inside the window gives no record
+   - the window counts engine cycles (sequence numbers), so
+     cycles the loop missed (EEPROM writes, long UART dumps)
+     are slots marked lost, not shifts of everything after
+     them; ms = cycles x the mean measured mains period
+   - a start with lost cycles before its settle point is kept
+     in the log as partial, but neither warns nor teaches the
+     baseline (the peak or the true settle may be missing)
+   - baseline: rolling mean (plain mean for the first
+     STARTPROF_LEARN_STARTS, then EMA 1/8) in EEPROM
+     (EE_ADDR_STARTPROF); only healthy starts update it
+   - a start off by more than marginPct in any metric sets a
+     maintenance warning (weak start capacitor, tight bearing)
+     and reports "START:WARN:<bits>"
+   ============================================================ */
+
+#define STARTPROF_WINDOW_CYCLES   200      // 4 s @ 50 Hz
+#define STARTPROF_STEADY_CYCLES   50       // last 1 s = steady state,
+                                           // needs half of it seen
+#define STARTPROF_SETTLE_PCT      10       // % band around steady I
+#define STARTPROF_LEARN_STARTS    4
+#define STARTPROF_MIN_STEADY_A    0.3f     // below this: no load, ignored
+#define STARTPROF_DEFAULT_MARGIN  30       // %
+#define STARTPROF_LOG_SIZE        4        // last starts kept in RAM
+
+#define STARTPROF_WARN_PEAK       0x01
+#define STARTPROF_WARN_SETTLE     0x02
+#define STARTPROF_WARN_POWER      0x04
+
+typedef struct {
+    float    peakA;             // highest cycle RMS current
+    float    settleMs;          // start -> within the settle band
+    float    steadyW;
+    uint8_t  warn;              // STARTPROF_WARN_* against the baseline
+    uint8_t  lost;              // cycles the loop missed (saturates)
+    bool     partial;           // lost cycles inside the inrush
+    uint32_t atMs;              // HAL tick of the start
+} StartRecord;
+
+typedef struct {
+    float    peakA;
+    float    settleMs;
+    float    steadyW;
+    uint16_t starts;            // healthy starts folded in
+    uint8_t  marginPct;
+} StartBaseline;
+
+void StartProf_Init(void);                      // load baseline
+void StartProf_OnStart(void);                   // motor_apply(true)
+void StartProf_OnCycle(float currentA, float powerW,   // ACS712_Update
+                       uint32_t seq, float hz);         // hz 0 = not synced
+
+const StartBaseline* StartProf_GetBaseline(void);
+const StartRecord*   StartProf_GetLog(uint8_t back);  // 0 = latest, NULL if none
+uint8_t StartProf_GetWarning(void);             // latched WARN bits
+void    StartProf_ClearWarning(void);
+void    StartProf_SetMargin(uint8_t pct);       // saved
+void    StartProf_ResetBaseline(void);          // saved
+
+#endif /* STARTPROF_H */
@@ -13,6 +13,8 @@ void UART_Init(void);
 bool UART_GetReceivedPacket(char *buffer, size_t buffer_size);
 void UART_TransmitString(UART_HandleTypeDef *huart, const char *str);
 void UART_TransmitByte(UART_HandleTypeDef *huart, uint8_t byte);
+void UART_TransmitPacket(const char *payload);   // sends "@payload#"
+void UART_TransmitBinary(const uint8_t *buf, uint16_t len);   // raw frames
 
 
 // New function to check and retrieve a complete received packet
@@ -1,139 +1,506 @@
 #include "acs712.h"
+#include "fixmath.h"
+#include "profiler.h"
+#include "calib.h"
+#include "drypower.h"
+#include "startprof.h"
+#include "sigbench.h"
+#include "powerq.h"
+#include "eeprom_i2c.h"
 #include "math.h"
+#include <string.h>
 
 float g_currentA = 0.0f;
 float g_voltageV = 0.0f;
+float g_mainsHz   = 0.0f;
+float g_powerW    = 0.0f;
 
-static ADC_HandleTypeDef *hAdc;
 float adc_rms;
-static float acs_zero_offset = 0.0f;
-static float zmpt_offset = 1.65f;
-static float last_voltage = 0.0f;
-static float last_current = 0.0f;
+
+/* Phase self-check (runs from ACS712_Update, one stage per mode) */
+typedef enum { PCHK_IDLE = 0, PCHK_SEQ, PCHK_DUAL } PhaseCheckStage;
+
+static PhaseCheckStage s_pchkStage = PCHK_IDLE;
+static MainsAcqMode    s_pchkRestore;
+static uint8_t         s_pchkCycles;
+static float           s_pchkSumP, s_pchkSumS;
+static MainsPhaseCheck s_pchk;
 
 /* -------------------------------------------------------
-   ADC READER
+   PER-CYCLE RMS ENGINE (voltage + current)
+   Rising zero crossings of the offset-removed ZMPT signal
+   delimit mains cycles. Each complete cycle publishes the
+   V and I sums over that same window and its period in
+   1/256 sample units (crossing is interpolated between
+   the two samples around it).
+   No crossing for ZC_MAX_SAMPLES → window is published
+   anyway with period 0 (mains absent), so UV still trips.
 -------------------------------------------------------- */
-static float adc_read(uint32_t channel)
+typedef struct {
+    uint32_t sum_v;
+    uint64_t sq_v;
+    uint32_t sum_i;
+    uint64_t sq_i;
+    uint64_t sum_vi;        // for active power
+    uint16_t n;
+    uint32_t period_q8;     // 0 = not synchronised
+    uint32_t seq;
+} MainsCycle;
+
+static volatile MainsCycle s_cycle;
+static uint32_t s_cycleSeen = 0;
+
+/* engine state – touched only from the DMA IRQ */
+static int32_t  zc_offset  = 2048;  // counts, mean of the previous cycle
+static int32_t  zc_prev    = 0;
+static bool     zc_armed   = false;
+static bool     zc_synced  = false;
+static uint32_t zc_clock   = 0;     // sample counter
+static uint32_t zc_last_q8 = 0;     // time of last rising crossing
+static uint32_t acc_sum    = 0;     // voltage
+static uint64_t acc_sq     = 0;
+static uint32_t acc_sum_i  = 0;     // current
+static uint64_t acc_sq_i   = 0;
+static uint64_t acc_vi     = 0;     // v*i products
+static uint16_t acc_n      = 0;
+
+static void cycle_publish(uint32_t period_q8)
+{
+    s_cycle.sum_v     = acc_sum;
+    s_cycle.sq_v      = acc_sq;
+    s_cycle.sum_i     = acc_sum_i;
+    s_cycle.sq_i      = acc_sq_i;
+    s_cycle.sum_vi    = acc_vi;
+    s_cycle.n         = acc_n;
+    s_cycle.period_q8 = period_q8;
+    s_cycle.seq++;
+
+    zc_offset = (int32_t)(acc_sum / acc_n);
+
+    acc_sum   = 0;
+    acc_sq    = 0;
+    acc_sum_i = 0;
+    acc_sq_i  = 0;
+    acc_vi    = 0;
+    acc_n     = 0;
+}
+
+static inline void cycle_sample(uint32_t v, uint32_t i)
 {
-    ADC_ChannelConfTypeDef cfg = {0};
-    cfg.Channel = channel;
-    cfg.Rank = ADC_REGULAR_RANK_1;
-    cfg.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
+    int32_t x = (int32_t)v - zc_offset;
+
+    if (x < -ZC_HYST_COUNTS)
+    {
+        zc_armed = true;
+    }
+    else if (zc_armed && x >= 0)
+    {
+        zc_armed = false;
 
-    HAL_ADC_ConfigChannel(hAdc, &cfg);
+        /* crossing lies between previous sample and this one */
+        uint32_t frac = (uint32_t)((-zc_prev) * 256) / (uint32_t)(x - zc_prev);
+        uint32_t t_q8 = (zc_clock - 1U) * 256U + frac;
 
-    HAL_ADC_Start(hAdc);
-    HAL_ADC_PollForConversion(hAdc, HAL_MAX_DELAY);
+        if (!zc_synced)
+        {
+            acc_sum = 0; acc_sq = 0;                // start first full cycle here
+            acc_sum_i = 0; acc_sq_i = 0; acc_vi = 0; acc_n = 0;
+            zc_synced = true;
+        }
+        else if (acc_n >= ZC_MIN_SAMPLES)
+        {
+            cycle_publish(t_q8 - zc_last_q8);
+        }
+        else
+        {
+            t_q8 = zc_last_q8;                      // glitch: keep the cycle open
+        }
+        zc_last_q8 = t_q8;
+    }
 
-    uint16_t raw = HAL_ADC_GetValue(hAdc);
-    HAL_ADC_Stop(hAdc);
+    acc_sum   += v;
+    acc_sq    += v * v;
+    acc_sum_i += i;
+    acc_sq_i  += i * i;
+    acc_vi    += v * i;
+    acc_n++;
+    zc_prev = x;
+    zc_clock++;
 
-    return (raw * ADC_VREF) / ADC_RES;
+    if (acc_n >= ZC_MAX_SAMPLES)
+    {
+        cycle_publish(0);
+        zc_synced = false;
+    }
+}
+
+/* Called by adc_scan for every DMA block (IRQ context) */
+void ACS712_ProcessBlock(const AdcScanFrame *f, uint16_t n)
+{
+    for (; n; n--, f++)
+        cycle_sample(f->v, f->i);
+}
+
+/* Copy the newest complete cycle out of IRQ reach; false if nothing new */
+static bool take_cycle(MainsCycle *out)
+{
+    __disable_irq();
+    *out = s_cycle;
+    __enable_irq();
+
+    if (out->seq == s_cycleSeen || out->n == 0)
+        return false;
+
+    s_cycleSeen = out->seq;
+    return true;
 }
 
 /* -------------------------------------------------------
-   OFFSET CALIBRATION (Voltage)
+   ZERO OFFSETS (ZMPT101B mid-rail, ACS712 zero current)
+   Loaded from EEPROM at boot so sync and the fast-trip window
+   are right from the first cycle. Each cycle mean then refines
+   a slow EMA (Q8 counts, alpha 1/64 ≈ 1.3 s); the EEPROM copy
+   is rewritten only when the EMA drifts ZERO_SAVE_DRIFT away
+   from it, at most every ZERO_SAVE_MIN_MS.
 -------------------------------------------------------- */
-static void zmpt_calibrate_offset(void)
+#define ZERO_EMA_SHIFT        6
+#define ZERO_SETTLE_CYCLES    250       // 5 s before the EMA may be saved
+#define ZERO_SAVE_DRIFT       8         // counts (~6.5 mV)
+#define ZERO_SAVE_MIN_MS      (10UL * 60UL * 1000UL)
+#define ZERO_SIGNATURE        0x2E0F
+
+typedef struct {
+    uint16_t v;                 // counts
+    uint16_t i;
+    uint16_t sig;
+    uint16_t check;
+} ZeroRecord;
+
+static int32_t  s_zeroQ8[2];    // [V, I], 0 = not seeded
+static uint16_t s_zeroSaved[2];
+static uint16_t s_zeroCycles = 0;
+static uint32_t s_zeroSavedMs;
+static bool     s_zeroEverSaved = false;
+
+static uint16_t zero_check(const ZeroRecord *r)
+{
+    return (uint16_t)(r->v ^ (r->i << 3) ^ (r->i >> 13) ^ r->sig ^ 0x5AA5);
+}
+
+static void zero_save(void)
 {
-    float sum = 0;
-    for (int i = 0; i < ZMPT_OFFSET_SAMPLES; i++)
-        sum += adc_read(ZMPT_ADC_CHANNEL);
+    ZeroRecord r;
+    r.v     = (uint16_t)((s_zeroQ8[0] + 128) >> 8);
+    r.i     = (uint16_t)((s_zeroQ8[1] + 128) >> 8);
+    r.sig   = ZERO_SIGNATURE;
+    r.check = zero_check(&r);
 
-    zmpt_offset = sum / ZMPT_OFFSET_SAMPLES;
+    if (EEPROM_WriteBuffer(EE_ADDR_ZERO_OFFS, (uint8_t*)&r, sizeof(r)) != HAL_OK)
+        return;                                 // retry on a later cycle
+
+    s_zeroSaved[0]  = r.v;
+    s_zeroSaved[1]  = r.i;
+    s_zeroSavedMs   = HAL_GetTick();
+    s_zeroEverSaved = true;
+}
+
+static bool zero_load(void)
+{
+    ZeroRecord r;
+
+    if (EEPROM_ReadBuffer(EE_ADDR_ZERO_OFFS, (uint8_t*)&r, sizeof(r)) != HAL_OK)
+        return false;
+    if (r.sig != ZERO_SIGNATURE || r.check != zero_check(&r) ||
+        r.v > 4095 || r.i > 4095)
+        return false;
+
+    s_zeroQ8[0]     = (int32_t)r.v << 8;
+    s_zeroQ8[1]     = (int32_t)r.i << 8;
+    s_zeroSaved[0]  = r.v;
+    s_zeroSaved[1]  = r.i;
+    s_zeroSavedMs   = HAL_GetTick();
+    s_zeroEverSaved = true;
+    return true;
+}
+
+static inline bool drifted(uint8_t ch)
+{
+    int32_t d = ((s_zeroQ8[ch] + 128) >> 8) - (int32_t)s_zeroSaved[ch];
+    return d > ZERO_SAVE_DRIFT || d < -ZERO_SAVE_DRIFT;
+}
+
+/* one cycle mean per channel, Q8 counts */
+static void zero_track(int32_t meanV_q8, int32_t meanI_q8)
+{
+    if (s_zeroQ8[0] == 0)
+    {
+        s_zeroQ8[0] = meanV_q8;                 // first boot: seed directly
+        s_zeroQ8[1] = meanI_q8;
+    }
+    else
+    {
+        s_zeroQ8[0] += (meanV_q8 - s_zeroQ8[0]) >> ZERO_EMA_SHIFT;
+        s_zeroQ8[1] += (meanI_q8 - s_zeroQ8[1]) >> ZERO_EMA_SHIFT;
+    }
+
+    if (s_zeroCycles < ZERO_SETTLE_CYCLES)
+    {
+        s_zeroCycles++;
+        return;
+    }
+
+    if (!s_zeroEverSaved)
+        zero_save();
+    else if ((drifted(0) || drifted(1)) &&
+             (HAL_GetTick() - s_zeroSavedMs) >= ZERO_SAVE_MIN_MS)
+        zero_save();
 }
 
 /* -------------------------------------------------------
-   OFFSET CALIBRATION (Current)
+   STREAM CONTROL
+   The gap breaks the running cycle – resync from scratch
+   (IRQ is quiet while the stream is stopped).
 -------------------------------------------------------- */
-static void acs_calibrate_offset(void)
+static void engine_reset(void)
 {
-    float sum = 0;
-    for (int i = 0; i < ACS712_ZERO_SAMPLES; i++)
-        sum += adc_read(ACS712_ADC_CHANNEL);
+    zc_synced = false;
+    zc_armed  = false;
+    acc_sum = 0; acc_sq = 0; acc_sum_i = 0; acc_sq_i = 0; acc_vi = 0; acc_n = 0;
+}
+
+void ACS712_SetAcqMode(MainsAcqMode mode)
+{
+    if (mode == AdcScan_GetMode())
+        return;
 
-    acs_zero_offset = sum / ACS712_ZERO_SAMPLES;
+    AdcScan_Stop();
+    engine_reset();
+    AdcScan_Start(mode);
+}
+
+MainsAcqMode ACS712_GetAcqMode(void)
+{
+    return AdcScan_GetMode();
 }
 
 /* -------------------------------------------------------
    INITIALIZATION
 -------------------------------------------------------- */
-void ACS712_Init(ADC_HandleTypeDef *hadc)
+void ACS712_Init(void)
 {
-    hAdc = hadc;
-
-    HAL_Delay(300);
-
-    zmpt_calibrate_offset();
-    acs_calibrate_offset();
+    /* no settling delay or blocking calibration: stored offsets
+       apply at once, the first cycles refine them in the background */
+    if (zero_load())
+    {
+        __disable_irq();
+        zc_offset = (s_zeroQ8[0] + 128) >> 8;
+        __enable_irq();
+    }
 }
 
 /* -------------------------------------------------------
-   TRUE RMS VOLTAGE READ (ZMPT101B)
+   PHASE SELF-CHECK
+   Measures the V-I angle acos(P/S) over MAINS_PCHK_CYCLES
+   in sequential mode, then in dual mode, then restores the
+   previous mode. With a steady load the difference is the
+   skew that sequential sampling adds (one conversion time).
 -------------------------------------------------------- */
-float ZMPT_ReadVoltageRMS(void)
+bool ACS712_StartPhaseCheck(void)
+{
+    if (s_pchkStage != PCHK_IDLE)
+        return false;
+
+    s_pchk.state  = MAINS_PCHK_RUNNING;
+    s_pchkRestore = AdcScan_GetMode();
+    s_pchkStage   = PCHK_SEQ;
+    s_pchkCycles  = 0;
+    s_pchkSumP    = 0.0f;
+    s_pchkSumS    = 0.0f;
+
+    ACS712_SetAcqMode(MAINS_ACQ_SEQUENTIAL);
+    return true;
+}
+
+const MainsPhaseCheck* ACS712_GetPhaseCheck(void)
+{
+    return &s_pchk;
+}
+
+static float angle_deg(float p, float s)
+{
+    float pf = p / s;
+    if (pf > 1.0f)  pf = 1.0f;
+    if (pf < -1.0f) pf = -1.0f;
+    return acosf(pf) * (180.0f / 3.14159265f);
+}
+
+static void phase_check_cycle(float p, float s)
 {
-    float sum_dc = 0.0f;
-    float sum_sq = 0.0f;
+    if (s_pchkStage == PCHK_IDLE)
+        return;
+
+    /* first cycles after a mode switch are discarded */
+    if (++s_pchkCycles <= MAINS_PCHK_SETTLE)
+        return;
+
+    s_pchkSumP += p;
+    s_pchkSumS += s;
+
+    if (s_pchkCycles < MAINS_PCHK_SETTLE + MAINS_PCHK_CYCLES)
+        return;
+
+    bool  loaded = (s_pchkSumS / MAINS_PCHK_CYCLES) >= MAINS_PCHK_MIN_VA;
+    float deg    = loaded ? angle_deg(s_pchkSumP, s_pchkSumS) : 0.0f;
 
-    for (int i = 0; i < ZMPT_RMS_SAMPLES; i++)
+    if (s_pchkStage == PCHK_SEQ)
     {
-        float v = adc_read(ZMPT_ADC_CHANNEL);
+        s_pchk.seqDeg = deg;
+        s_pchkStage   = loaded ? PCHK_DUAL : PCHK_IDLE;
+        s_pchkCycles  = 0;
+        s_pchkSumP    = 0.0f;
+        s_pchkSumS    = 0.0f;
 
-        sum_dc += v;
+        if (loaded)
+        {
+            ACS712_SetAcqMode(MAINS_ACQ_DUAL);
+            return;
+        }
+        s_pchk.state = MAINS_PCHK_NO_LOAD;
+    }
+    else
+    {
+        /* one ADC conversion (71.5 + 12.5 ADC clocks) in degrees of mains */
+        float tconv = 84.0f / (float)HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_ADC);
 
-        float ac = v - zmpt_offset;
-        sum_sq += ac * ac;
+        s_pchk.dualDeg     = deg;
+        s_pchk.expectedDeg = 360.0f * g_mainsHz * tconv;
+        s_pchk.state       = loaded ? MAINS_PCHK_DONE : MAINS_PCHK_NO_LOAD;
+        s_pchkStage        = PCHK_IDLE;
     }
 
-    float new_offset = sum_dc / ZMPT_RMS_SAMPLES;
+    ACS712_SetAcqMode(s_pchkRestore);
+}
 
-    zmpt_offset = (zmpt_offset * 0.90f) + (new_offset * 0.10f);
+static inline float q8_counts_to_volts(uint32_t q8)
+{
+    return (float)q8 * (ADC_VREF / ADC_RES / 256.0f);
+}
 
-    adc_rms = sqrtf(sum_sq / ZMPT_RMS_SAMPLES);
+/* -------------------------------------------------------
+   UPDATE BOTH SENSOR VALUES
+   Non-blocking: one fresh, unfiltered V/I RMS pair per
+   mains cycle (~20 ms); keeps the last values in between.
+-------------------------------------------------------- */
+void ACS712_Update(void)
+{
+    MainsCycle c;
+    if (!take_cycle(&c))
+        return;
 
-    /* --------------------------
-       DEBUG FOR PERFECT CALIB
-       (DO NOT REMOVE NOW)
-    --------------------------- */
+    /* ---- offsets: cycle means feed the persisted zero estimate ---- */
+    zero_track((int32_t)(((uint64_t)c.sum_v << 8) / c.n),
+               (int32_t)(((uint64_t)c.sum_i << 8) / c.n));
 
-    /* New calculation using multimeter voltage */
-    #define ZMPT_CALIBRATION 239.5f  // Updated calibration factor (Multimeter RMS = 5.0 V)
+    /* ---- voltage (ZMPT101B) ---- */
+    adc_rms = q8_counts_to_volts(cycle_rms_q8(c.sum_v, c.sq_v, c.n));
 
-    float Vrms = adc_rms * ZMPT_CALIBRATION;
+    /* ---- current (ACS712), same window ---- */
+    float i_rms = q8_counts_to_volts(cycle_rms_q8(c.sum_i, c.sq_i, c.n));
 
-    last_voltage =
-        last_voltage * (1.0f - ZMPT_FILTER_ALPHA) +
-        (Vrms * ZMPT_FILTER_ALPHA);
+    /* ---- runtime calibration (raw ADC RMS volts -> V / A) ---- */
+    const CalibFactors *cal = Calib_Get();
 
-    g_voltageV = last_voltage;
-    return g_voltageV;
+    Calib_OnCycle(adc_rms, i_rms);
+
+    g_voltageV = Calib_Apply(cal, CALIB_CH_V, adc_rms);
+    g_currentA = Calib_Apply(cal, CALIB_CH_I, i_rms);
+
+    /* ---- active power = mean(v*i) with both offsets removed ----
+       n*sum(vi) - sum(v)*sum(i) = n^2 * covariance(v, i)            */
+    int64_t cov = (int64_t)((uint64_t)c.n * c.sum_vi)
+                - (int64_t)((uint64_t)c.sum_v * c.sum_i);
+    float   k   = (ADC_VREF / ADC_RES) * (ADC_VREF / ADC_RES);
+
+    g_powerW = ((float)cov / ((float)c.n * c.n)) * k
+             * cal->gain[CALIB_CH_V] * cal->gain[CALIB_CH_I];
+
+    phase_check_cycle(g_powerW, g_voltageV * g_currentA);
+    DryPower_OnCycle(g_powerW, g_voltageV * g_currentA);
+    g_mainsHz = (c.period_q8 != 0)
+              ? ((float)MAINS_SAMPLE_RATE_HZ * 256.0f) / (float)c.period_q8
+              : 0.0f;
+
+    StartProf_OnCycle(g_currentA, g_powerW, c.seq, g_mainsHz);
+
+    PowerQ_OnCycle(g_voltageV, g_mainsHz, c.seq);
+}
+
+/* Sequence of the newest published cycle (taken or not) */
+uint32_t ACS712_GetCycleSeq(void)
+{
+    return s_cycle.seq;
+}
+
+/* Scale of one raw count, for tools that plot raw samples */
+float ACS712_VoltsPerCount(void)
+{
+    return (ADC_VREF / ADC_RES) * Calib_Get()->gain[CALIB_CH_V];
+}
+
+float ACS712_AmpsPerCount(void)
+{
+    return (ADC_VREF / ADC_RES) * Calib_Get()->gain[CALIB_CH_I];
 }
 
 /* -------------------------------------------------------
-   CURRENT READING (ACS712)
+   SIGNAL PATH BENCHMARK (float vs fixed, DWT cycles)
+   Both sigbench.c kernels run over a snapshot of the live
+   DMA block, best of MAINS_BENCH_RUNS, reported per V/I
+   sample pair.
 -------------------------------------------------------- */
-float ACS712_ReadCurrent(void)
+void ACS712_BenchSignalPath(MainsBench *out)
 {
-    float v = adc_read(ACS712_ADC_CHANNEL);
-    float diff = v - acs_zero_offset;
+    AdcScanFrame blk[MAINS_BLOCK_SAMPLES];
+    uint32_t bestF = UINT32_MAX, bestX = UINT32_MAX;
 
-    float amp = diff / ACS712_SENS_30A;
+    memcpy(blk, AdcScan_LastBlock(), sizeof(blk));     // a torn block is still valid data
 
-    last_current =
-        last_current * (1.0f - ACS712_FILTER_ALPHA) +
-        (amp * ACS712_FILTER_ALPHA);
+    for (uint8_t r = 0; r < MAINS_BENCH_RUNS; r++)
+    {
+        uint32_t t0 = Prof_Begin();
+        SigBench_Float(blk, MAINS_BLOCK_SAMPLES);
+        uint32_t t1 = Prof_Begin();
+        SigBench_Fixed(blk, MAINS_BLOCK_SAMPLES);
+        uint32_t t2 = Prof_Begin();
 
-    g_currentA = last_current;
-    return g_currentA;
+        if (t1 - t0 < bestF) bestF = t1 - t0;
+        if (t2 - t1 < bestX) bestX = t2 - t1;
+    }
+
+    out->floatCycPerSample = bestF / MAINS_BLOCK_SAMPLES;
+    out->fixedCycPerSample = bestX / MAINS_BLOCK_SAMPLES;
+}
+
+/* ACS712 zero offset in ADC counts (persisted, slowly tracked) */
+int32_t ACS712_GetZeroCounts(void)
+{
+    return (s_zeroQ8[1] + 128) >> 8;
 }
 
 /* -------------------------------------------------------
-   UPDATE BOTH SENSOR VALUES
+   TRUE RMS VOLTAGE READ (ZMPT101B)
 -------------------------------------------------------- */
-void ACS712_Update(void)
+float ZMPT_ReadVoltageRMS(void)
 {
-    ACS712_ReadCurrent();
-    ZMPT_ReadVoltageRMS();
+    ACS712_Update();
+    return g_voltageV;
+}
+
+/* -------------------------------------------------------
+   TRUE RMS CURRENT READ (ACS712)
+-------------------------------------------------------- */
+float ACS712_ReadCurrent(void)
+{
+    ACS712_Update();
+    return g_currentA;
 }
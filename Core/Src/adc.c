@@ -4,26 +4,24 @@
 #include "global.h"
 #include "led.h"     // ✅ for LED control
 
-#include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
-#include <math.h>
 #include "model_handle.h"
+#include "fixmath.h"
+#include "adc_scan.h"
+#include "lora.h"
+#include "level.h"
 
-#ifndef THR
-#define THR                       1.0f
-#endif
-
-#define EMA_ALPHA                 0.3f
-#define HYST_DELTA                0.10f
 #define GROUND_THRESHOLD           0.5f
-#define DRY_VOLTAGE_THRESHOLD     0.05f
-#define DRY_COUNT_THRESHOLD          3
-#define PRINT_DELTA                0.05f  // only print if change > 0.05V
+#define MAX_REACHED_V              3.2f
 
 // === AC / Current sensing config ===
 #define VREF                      3.3f
 #define ADC_RES                   4095.0f
+
+/* Filtering runs in integer counts; volt thresholds above are
+   folded to counts at compile time, volts only leave via ADC_Data */
+#define V_TO_COUNTS(v)            ((int32_t)((v) * ADC_RES / VREF + 0.5f))
 // === Exported for monitoring (Live Expressions) ===
 float g_adcVoltages[ADC_CHANNEL_COUNT] = {0};
 
@@ -34,157 +32,229 @@ float g_acCurrent_avg = 0.0f;     // smoothed AC current
 
 bool  g_overload  = false;
 
-static float    s_filtered[ADC_CHANNEL_COUNT] = {0};
-static uint8_t  s_level_flags[ADC_CHANNEL_COUNT] = {0};
-static uint8_t  s_low_counts[ADC_CHANNEL_COUNT] = {0};
-static float    s_prev_volt[ADC_CHANNEL_COUNT] = {0};
-
-// Existing channels (water sensors etc.)
-static const uint32_t adcChannels[ADC_CHANNEL_COUNT] = {
-    ADC_CHANNEL_0,//dry run
-    ADC_CHANNEL_1,//water level
-    ADC_CHANNEL_2,//water level
-    ADC_CHANNEL_3,//water level
-    ADC_CHANNEL_4,//water level
-    ADC_CHANNEL_5 //water level
+static uint16_t s_hist[ADC_CHANNEL_COUNT][3];          // last three block values
+static uint16_t s_filt[ADC_CHANNEL_COUNT];             // filtered, before the ground clamp
+static uint8_t  s_histPos = 0;
+static bool     s_seeded  = false;
+
+/* Probes arrive once per mains cycle from the adc_scan DMA burst,
+   already a median of 8 sub-block means (intra-cycle spikes gone):
+   probe[0] = ADC_CHANNEL_0 (dry run), probe[1..5] = water level */
+
+/* ---- water-level probe FSM: one const row per probe (flash) ----
+   WET  after dwellWet  cycles at/above wetOn
+   DRY  after dwellDry  cycles below dryBelow
+   in between (hysteresis band) the state holds                  */
+typedef struct {
+    uint16_t    wetOn;          // counts
+    uint16_t    dryBelow;       // counts
+    uint8_t     dwellWet;       // cycles (20 ms)
+    uint8_t     dwellDry;
+    const char *tag;            // LoRa packet on WET
+} ProbeCfg;
+
+static const ProbeCfg s_probeCfg[ADC_LEVEL_PROBES] = {
+    { V_TO_COUNTS(1.0f), V_TO_COUNTS(GROUND_THRESHOLD), 2, 3, "@30W#"  },
+    { V_TO_COUNTS(1.0f), V_TO_COUNTS(GROUND_THRESHOLD), 2, 3, "@70W#"  },
+    { V_TO_COUNTS(1.0f), V_TO_COUNTS(GROUND_THRESHOLD), 2, 3, "@1:W#"  },
+    { V_TO_COUNTS(1.0f), V_TO_COUNTS(GROUND_THRESHOLD), 2, 3, "@DRY#"  },
+    { V_TO_COUNTS(1.0f), V_TO_COUNTS(GROUND_THRESHOLD), 2, 3, "@FULL#" },
 };
 
-// ⚠️ Add dedicated channels for AC voltage/current (configure in CubeMX!)
-#define ADC_CHANNEL_AC_VOLTAGE    ADC_CHANNEL_6
-#define ADC_CHANNEL_AC_CURRENT    ADC_CHANNEL_7
+static ProbeState s_probeState[ADC_LEVEL_PROBES];
+static uint8_t    s_dwell[ADC_LEVEL_PROBES];
 
-static char dataPacketTx[16];
+/* event FIFO: the probe task produces, the LoRa task drains –
+   both run from the main loop, so no locking is needed */
+#define PROBE_EVT_QUEUE   16            // power of two
 
-/* --- helper: sample one channel --- */
-static float readChannelVoltage(ADC_HandleTypeDef *hadc, uint32_t channel)
+static ProbeEvent s_evtQ[PROBE_EVT_QUEUE];
+static uint8_t    s_evtHead = 0;
+static uint8_t    s_evtTail = 0;
+static uint16_t   s_evtDropped = 0;
+
+static void push_event(uint8_t probe, ProbeEventType type)
 {
-    ADC_ChannelConfTypeDef sConfig = {0};
-    sConfig.Channel = channel;
-    sConfig.Rank = 1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
-
-    if (HAL_ADC_ConfigChannel(hadc, &sConfig) != HAL_OK)
-        return 0.0f;
-    if (HAL_ADC_Start(hadc) != HAL_OK)
-        return 0.0f;
-
-    float v = 0.0f;
-    if (HAL_ADC_PollForConversion(hadc, 10) == HAL_OK) {
-        uint32_t raw = HAL_ADC_GetValue(hadc);
-        v = (raw * VREF) / ADC_RES;
+    uint8_t next = (uint8_t)((s_evtHead + 1U) & (PROBE_EVT_QUEUE - 1U));
+
+    if (next == s_evtTail)
+    {
+        s_evtDropped++;                 // reporter stalled: keep the oldest
+        return;
     }
-    HAL_ADC_Stop(hadc);
-    return v;
+    s_evtQ[s_evtHead].probe = probe;
+    s_evtQ[s_evtHead].type  = (uint8_t)type;
+    s_evtHead = next;
 }
 
-/* --- helper: average multiple samples for better stability --- */
-static float readChannelAveraged(ADC_HandleTypeDef *hadc, uint32_t channel, uint8_t samples)
+static void probe_step(uint8_t k, int32_t c)
 {
-    float sum = 0.0f;
-    for (uint8_t i = 0; i < samples; i++) {
-        sum += readChannelVoltage(hadc, channel);
+    const ProbeCfg *cfg = &s_probeCfg[k];
+    ProbeState      st  = s_probeState[k];
+    ProbeState      to;
+    uint8_t         need;
+
+    if (c >= cfg->wetOn && st != PROBE_WET)
+    {
+        to   = PROBE_WET;
+        need = cfg->dwellWet;
     }
-    return sum / samples;
+    else if (c < cfg->dryBelow && st != PROBE_DRY)
+    {
+        to   = PROBE_DRY;
+        need = cfg->dwellDry;
+    }
+    else
+    {
+        s_dwell[k] = 0;                 // in band or already there
+        return;
+    }
+
+    if (++s_dwell[k] < need)
+        return;
+
+    s_dwell[k]       = 0;
+    s_probeState[k]  = to;
+    push_event((uint8_t)(k + 1U), (to == PROBE_WET) ? PROBE_EVT_WET : PROBE_EVT_DRY);
+}
+
+/* --- helper: median of the last three cycles drops a one-cycle
+       splash outright instead of smearing it like the old EMA --- */
+static int32_t filterCounts(uint8_t ch, uint16_t raw)
+{
+    uint16_t *h = s_hist[ch];
+
+    h[s_histPos] = raw;
+    return median3_u16(h[0], h[1], h[2]);
+}
+
+static inline float countsToVolts(int32_t counts)
+{
+    return (float)counts * (VREF / ADC_RES);
 }
 
 /* --- Public API --- */
 void ADC_Init(ADC_HandleTypeDef* hadc)
 {
-    if (HAL_ADCEx_Calibration_Start(hadc) != HAL_OK) {
-        Error_Handler();
-    }
+    /* one TIM3-triggered DMA sequence feeds both the probes and
+       the V/I engine in acs712.c */
+    AdcScan_Init(hadc);
 }
 
-void ADC_ReadAllChannels(ADC_HandleTypeDef* hadc, ADC_Data* data)
+void ADC_ReadAllChannels(ADC_Data* data)
 {
-    bool changed = false;
-    char loraPacket[32];
-    loraPacket[0] = '\0';
+    AdcProbeScan scan;
+    bool anyDry = false;
+    bool ladder = (Level_GetSource() != LEVEL_SRC_PROBES);
+
+    /* one new block per mains cycle; nothing new → keep last values */
+    if (!AdcScan_GetProbes(&scan))
+        return;
+
+    if (!s_seeded)
+    {
+        for (uint8_t i = 0; i < ADC_CHANNEL_COUNT; i++)
+            s_hist[i][0] = s_hist[i][1] = s_hist[i][2] = scan.probe[i];
+        s_seeded = true;
+    }
 
     for (uint8_t i = 0; i < ADC_CHANNEL_COUNT; i++)
     {
-        float v = readChannelVoltage(hadc, adcChannels[i]);
+        int32_t c = filterCounts(i, scan.probe[i]);
+        s_filt[i] = (uint16_t)c;
 
         if (i == 0)
         {
             // Keep filtering so ModelHandle_CheckDryRun() works
-            if (s_filtered[0] == 0.0f)
-                s_filtered[0] = v;
-            else
-                s_filtered[0] = EMA_ALPHA * v + (1 - EMA_ALPHA) * s_filtered[0];
-
-            v = s_filtered[0];
-
-            data->voltages[0]   = v;
-            data->rawValues[0]  = (uint16_t)((v * ADC_RES) / VREF);
+            data->voltages[0]   = countsToVolts(c);
+            data->rawValues[0]  = (uint16_t)c;
             data->maxReached[0] = false;
-            g_adcVoltages[0]    = v;
+            g_adcVoltages[0]    = data->voltages[0];
 
             continue; // 🔥 IMPORTANT: skip water-level logic
         }
-        if (s_filtered[i] == 0.0f)
-            s_filtered[i] = v;
-        else
-            s_filtered[i] = EMA_ALPHA * v + (1 - EMA_ALPHA) * s_filtered[i];
 
-        v = s_filtered[i];
+        if (c < V_TO_COUNTS(GROUND_THRESHOLD))
+            c = 0;
 
-        if (v < GROUND_THRESHOLD)
-            v = 0.0f;
+        data->voltages[i]   = countsToVolts(c);
+        data->rawValues[i]  = (uint16_t)c;
+        data->maxReached[i] = (c >= V_TO_COUNTS(MAX_REACHED_V));
+        g_adcVoltages[i]    = data->voltages[i];
 
-        data->voltages[i]   = v;
-        data->rawValues[i]  = (uint16_t)((v * ADC_RES) / VREF);
-        data->maxReached[i] = (v >= 3.2f);
-        g_adcVoltages[i]    = v;
+        /* ladder / pressure: channels 1..5 are not single probes */
+        if (ladder)
+            continue;
 
-        // Detect meaningful change (used for LoRa)
-        if (fabsf(v - s_prev_volt[i]) > PRINT_DELTA) {
-            changed = true;
-            s_prev_volt[i] = v;
-        }
-        if (!s_level_flags[i] && v >= THR)
-        {
-            s_level_flags[i] = 1;
-
-            switch (i) {
-                case 1: snprintf(dataPacketTx, sizeof(dataPacketTx), "@30W#"); break;
-                case 2: snprintf(dataPacketTx, sizeof(dataPacketTx), "@70W#"); break;
-                case 3: snprintf(dataPacketTx, sizeof(dataPacketTx), "@1:W#");  break;
-                case 4: snprintf(dataPacketTx, sizeof(dataPacketTx), "@DRY#"); break;
-                case 5: snprintf(dataPacketTx, sizeof(dataPacketTx), "@FULL#"); break;
-                default: dataPacketTx[0] = '\0'; break;
-            }
-
-            s_low_counts[i] = 0;
-
-            if (dataPacketTx[0]) {
-                strncat(loraPacket, dataPacketTx, sizeof(loraPacket)-strlen(loraPacket)-1);
-                strncat(loraPacket, ";", sizeof(loraPacket)-strlen(loraPacket)-1);
-            }
-        }
-        else if (s_level_flags[i] && v < (THR - HYST_DELTA))
-        {
-            s_level_flags[i] = 0;
-        }
+        probe_step((uint8_t)(i - 1U), c);
+        if (s_probeState[i - 1U] == PROBE_DRY)
+            anyDry = true;
+    }
 
-        // Debounce for DRY LOW signal (water-level only)
-        if (v < DRY_VOLTAGE_THRESHOLD) {
-            if (s_low_counts[i] < 0xFF) s_low_counts[i]++;
-        } else {
-            s_low_counts[i] = 0;
-        }
+    if (++s_histPos >= 3)
+        s_histPos = 0;
+
+    /* legacy: a dry level probe drops the motor flag */
+    if (!manualOverride && motorStatus == 1 && anyDry)
+        motorStatus = 0;
+}
+
+uint16_t ADC_GetFilteredCounts(uint8_t ch)
+{
+    return (ch < ADC_CHANNEL_COUNT) ? s_filt[ch] : 0;
+}
 
-        if (!manualOverride) {
-            if (motorStatus == 1 && s_low_counts[i] >= DRY_COUNT_THRESHOLD) {
-                motorStatus = 0;
-                memset(s_low_counts, 0, sizeof(s_low_counts));
-            }
+bool ADC_PeekProbeEvent(ProbeEvent *evt)
+{
+    if (s_evtTail == s_evtHead)
+        return false;
+
+    *evt = s_evtQ[s_evtTail];
+    return true;
+}
+
+bool ADC_PopProbeEvent(ProbeEvent *evt)
+{
+    if (!ADC_PeekProbeEvent(evt))
+        return false;
+
+    s_evtTail = (uint8_t)((s_evtTail + 1U) & (PROBE_EVT_QUEUE - 1U));
+    return true;
+}
+
+ProbeState ADC_GetProbeState(uint8_t probe)
+{
+    if (probe == 0 || probe > ADC_LEVEL_PROBES)
+        return PROBE_UNKNOWN;
+    return s_probeState[probe - 1U];
+}
+
+/* LoRa task side: WET edges → legacy "@30W#;@70W#;" packets */
+void ADC_ReportProbeEvents(void)
+{
+    char       pkt[32];
+    uint8_t    len = 0;
+    ProbeEvent e;
+
+    /* peek first: an event whose tag no longer fits stays queued */
+    while (ADC_PeekProbeEvent(&e))
+    {
+        if (e.type == PROBE_EVT_WET)
+        {
+            const char *tag = s_probeCfg[e.probe - 1U].tag;
+            uint8_t     n   = (uint8_t)strlen(tag);
+
+            if (len + n + 1U >= sizeof(pkt))
+                break;                  // rest goes out next pass
+            memcpy(&pkt[len], tag, n);
+            len += n;
+            pkt[len++] = ';';
         }
+        ADC_PopProbeEvent(&e);
     }
 
-    if (changed && loraPacket[0] != '\0') {
-        LoRa_SendPacket((uint8_t*)loraPacket, strlen(loraPacket));
-    }
+    if (len)
+        LoRa_SendPacket((uint8_t*)pkt, len);
 }
 
 uint8_t ADC_CheckMaxVoltage(ADC_Data* data, float threshold)
@@ -0,0 +1,213 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  ADC SCAN – one TIM3-triggered DMA sequence of all 8 inputs
+ *
+ *  SEQUENTIAL: ADC1 scan of 8 ranks, 16-bit DMA.
+ *  DUAL:       ADC1 and ADC2 in regular simultaneous mode with
+ *              4 ranks each, 32-bit DMA of ADC1->DR (ADC1 data
+ *              low half, ADC2 data high half).
+ *
+ *  Rank tables are chosen so both modes land in memory as the
+ *  same AdcScanFrame: [V, I, P0, P1, P2, P3, P4, P5].
+ *  8 x (71.5 + 12.5) ADC clocks @ 10.67 MHz = 63 us per frame,
+ *  well inside the 312 us TIM3 period.
+ ***************************************************************/
+
+#include "adc_scan.h"
+#include "acs712.h"
+#include "faultcap.h"
+#include "fixmath.h"
+#include "profiler.h"
+#include "main.h"
+
+extern ADC_HandleTypeDef hadc2;     // dual-mode slave
+extern DMA_HandleTypeDef hdma_adc1;
+extern TIM_HandleTypeDef htim3;     // TRGO = frame clock
+
+static const uint32_t seqRanks[ADC_SCAN_RANKS] = {
+    ZMPT_ADC_CHANNEL, ACS712_ADC_CHANNEL,
+    ADC_CHANNEL_0, ADC_CHANNEL_1, ADC_CHANNEL_2,
+    ADC_CHANNEL_3, ADC_CHANNEL_4, ADC_CHANNEL_5
+};
+
+/* word k = ADC1 rank k | ADC2 rank k << 16 */
+static const uint32_t dualRanks1[ADC_SCAN_RANKS / 2] = {
+    ZMPT_ADC_CHANNEL,   ADC_CHANNEL_0, ADC_CHANNEL_2, ADC_CHANNEL_4
+};
+static const uint32_t dualRanks2[ADC_SCAN_RANKS / 2] = {
+    ACS712_ADC_CHANNEL, ADC_CHANNEL_1, ADC_CHANNEL_3, ADC_CHANNEL_5
+};
+
+_Static_assert(sizeof(AdcScanFrame) == ADC_SCAN_RANKS * sizeof(uint16_t),
+               "AdcScanFrame must match the DMA halfword layout");
+
+#define SUB_FRAMES      (ADC_SCAN_BLOCK_FRAMES / ADC_SCAN_PROBE_SUBBLOCKS)
+#define SUB_SHIFT       3                               // log2(SUB_FRAMES)
+
+_Static_assert(SUB_FRAMES == (1U << SUB_SHIFT),
+               "probe sub-block must be a power of two frames");
+
+static AdcScanFrame s_dmaBuf[2 * ADC_SCAN_BLOCK_FRAMES] __attribute__((aligned(4)));
+
+static ADC_HandleTypeDef *hAdc;
+static MainsAcqMode       s_mode = MAINS_ACQ_DEFAULT;
+static uint8_t            s_lastHalf = 0;
+
+static volatile AdcProbeScan s_probes;
+static uint32_t              s_probesSeen = 0;
+
+static void regular_setup(ADC_HandleTypeDef *h, const uint32_t *ranks, uint8_t n)
+{
+    ADC_ChannelConfTypeDef cfg = {0};
+
+    h->Init.ScanConvMode    = ADC_SCAN_ENABLE;
+    h->Init.NbrOfConversion = n;
+    HAL_ADC_Init(h);
+
+    cfg.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
+    for (uint8_t r = 0; r < n; r++)
+    {
+        cfg.Channel = ranks[r];
+        cfg.Rank    = ADC_REGULAR_RANK_1 + r;
+        HAL_ADC_ConfigChannel(h, &cfg);
+    }
+}
+
+static void dma_align(uint32_t periph, uint32_t mem)
+{
+    hdma_adc1.Init.PeriphDataAlignment = periph;
+    hdma_adc1.Init.MemDataAlignment    = mem;
+    HAL_DMA_Init(&hdma_adc1);
+}
+
+/* HAL_ADC_Init powers ADC1 down, so DUALMOD can be written and
+   both converters are recalibrated before the stream restarts */
+void AdcScan_Start(MainsAcqMode mode)
+{
+    ADC_MultiModeTypeDef mm = {0};
+
+    s_mode = mode;
+
+    if (mode == MAINS_ACQ_DUAL)
+    {
+        regular_setup(hAdc,   dualRanks1, ADC_SCAN_RANKS / 2);
+        regular_setup(&hadc2, dualRanks2, ADC_SCAN_RANKS / 2);
+        dma_align(DMA_PDATAALIGN_WORD, DMA_MDATAALIGN_WORD);
+
+        mm.Mode = ADC_DUALMODE_REGSIMULT;
+        HAL_ADCEx_MultiModeConfigChannel(hAdc, &mm);
+
+        HAL_ADCEx_Calibration_Start(hAdc);
+        HAL_ADCEx_Calibration_Start(&hadc2);
+
+        HAL_ADCEx_MultiModeStart_DMA(hAdc, (uint32_t*)s_dmaBuf,
+                                     sizeof(s_dmaBuf) / (sizeof(uint32_t)));
+    }
+    else
+    {
+        regular_setup(hAdc, seqRanks, ADC_SCAN_RANKS);
+        dma_align(DMA_PDATAALIGN_HALFWORD, DMA_MDATAALIGN_HALFWORD);
+
+        mm.Mode = ADC_MODE_INDEPENDENT;
+        HAL_ADCEx_MultiModeConfigChannel(hAdc, &mm);
+
+        HAL_ADCEx_Calibration_Start(hAdc);
+
+        HAL_ADC_Start_DMA(hAdc, (uint32_t*)s_dmaBuf,
+                          sizeof(s_dmaBuf) / (sizeof(uint16_t)));
+    }
+
+    HAL_TIM_Base_Start(&htim3);
+}
+
+void AdcScan_Init(ADC_HandleTypeDef *hadc)
+{
+    hAdc = hadc;
+    AdcScan_Start(MAINS_ACQ_DEFAULT);
+}
+
+void AdcScan_Stop(void)
+{
+    HAL_TIM_Base_Stop(&htim3);
+
+    if (s_mode == MAINS_ACQ_DUAL)
+        HAL_ADCEx_MultiModeStop_DMA(hAdc);
+    else
+        HAL_ADC_Stop_DMA(hAdc);
+}
+
+MainsAcqMode AdcScan_GetMode(void)
+{
+    return s_mode;
+}
+
+/* Called from the ADC DMA half/full-transfer callbacks (IRQ context) */
+void AdcScan_BlockReady(uint8_t half)
+{
+    const AdcScanFrame *f = &s_dmaBuf[half ? ADC_SCAN_BLOCK_FRAMES : 0];
+    uint16_t sub[ADC_SCAN_PROBES][ADC_SCAN_PROBE_SUBBLOCKS];
+
+    s_lastHalf = half;
+
+    ACS712_ProcessBlock(f, ADC_SCAN_BLOCK_FRAMES);
+    FaultCap_Block(f, ADC_SCAN_BLOCK_FRAMES);
+
+    uint32_t t0 = Prof_Begin();
+
+    /* burst of 8-frame means per probe (shift, no divide) ... */
+    for (uint8_t s = 0; s < ADC_SCAN_PROBE_SUBBLOCKS; s++)
+    {
+        uint32_t sum[ADC_SCAN_PROBES] = {0};
+
+        for (uint8_t n = 0; n < SUB_FRAMES; n++, f++)
+            for (uint8_t p = 0; p < ADC_SCAN_PROBES; p++)
+                sum[p] += f->probe[p];
+
+        for (uint8_t p = 0; p < ADC_SCAN_PROBES; p++)
+            sub[p][s] = (uint16_t)((sum[p] + SUB_FRAMES / 2) >> SUB_SHIFT);
+    }
+
+    /* ... decimated to one value per cycle: the highest and lowest
+       sub-block drop out (a sort here cost more than it saved) */
+    for (uint8_t p = 0; p < ADC_SCAN_PROBES; p++)
+        s_probes.probe[p] = trim_mean_u16(sub[p], ADC_SCAN_PROBE_SUBBLOCKS);
+    s_probes.seq++;
+
+    Prof_End(PROF_PROBE_DECIM, t0);
+}
+
+/* Copy the newest probe block out of IRQ reach; false if nothing new */
+bool AdcScan_GetProbes(AdcProbeScan *out)
+{
+    __disable_irq();
+    *out = s_probes;
+    __enable_irq();
+
+    if (out->seq == s_probesSeen)
+        return false;
+
+    s_probesSeen = out->seq;
+    return true;
+}
+
+const AdcScanFrame* AdcScan_LastBlock(void)
+{
+    return &s_dmaBuf[s_lastHalf ? ADC_SCAN_BLOCK_FRAMES : 0];
+}
+
+const AdcScanFrame* AdcScan_Ring(void)
+{
+    return s_dmaBuf;
+}
+
+/* From the DMA down-counter: I is the 2nd halfword of a frame in
+   SEQUENTIAL mode and inside the 1st word in DUAL mode */
+uint16_t AdcScan_NewestIFrame(void)
+{
+    uint32_t perFrame = (s_mode == MAINS_ACQ_DUAL) ? ADC_SCAN_RANKS / 2 : ADC_SCAN_RANKS;
+    uint32_t iItems   = (s_mode == MAINS_ACQ_DUAL) ? 1U : 2U;
+    uint32_t total    = ADC_SCAN_RING_FRAMES * perFrame;
+    uint32_t written  = total - hdma_adc1.Instance->CNDTR;
+
+    return (uint16_t)(((written + total - iItems) % total) / perFrame);
+}
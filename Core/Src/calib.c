@@ -0,0 +1,145 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  CALIB – runtime gain/offset for the ZMPT101B and ACS712
+ *
+ *  Averaging runs from ACS712_Update (one call per mains cycle),
+ *  so a calibration never blocks the loop. The result is saved
+ *  and reported with "CAL:<ch>:<gain>:<offset>" when it is done.
+ ***************************************************************/
+
+#include "calib.h"
+#include "eeprom_i2c.h"
+#include "uart.h"
+#include <string.h>
+#include <math.h>
+
+#define CALIB_SIGNATURE   0xCA1B
+#define RAW_MIN_V         0.005f       // below this the channel is dead
+
+
+static const CalibFactors s_defaults = {
+    .gain   = { CALIB_DEFAULT_V_GAIN, CALIB_DEFAULT_I_GAIN },
+    .offset = { 0.0f, 0.0f }
+};
+
+static CalibFactors s_cal;
+
+/* running calibration */
+static CalibState   s_state = CALIB_IDLE;
+static CalibChannel s_ch;
+static float        s_ref;
+static float        s_sum;
+static uint8_t      s_cycles;
+
+/* last point per channel in this session (two-point fit) */
+static bool  s_havePt[CALIB_CH_COUNT];
+static float s_ptRaw[CALIB_CH_COUNT];
+static float s_ptRef[CALIB_CH_COUNT];
+
+static void save(void)
+{
+    EEPROM_WriteRecord(EE_ADDR_CALIB, &s_cal, sizeof(s_cal), CALIB_SIGNATURE);
+}
+
+void Calib_Init(void)
+{
+    CalibFactors f;
+
+    s_cal = s_defaults;
+
+    if (!EEPROM_ReadRecord(EE_ADDR_CALIB, &f, sizeof(f), CALIB_SIGNATURE))
+        return;
+    if (!isfinite(f.gain[CALIB_CH_V]) || !isfinite(f.gain[CALIB_CH_I]))
+        return;
+
+    s_cal = f;
+}
+
+const CalibFactors* Calib_Get(void)
+{
+    return &s_cal;
+}
+
+CalibState Calib_GetState(void)
+{
+    return s_state;
+}
+
+bool Calib_Start(CalibChannel ch, float reference)
+{
+    if (s_state == CALIB_RUNNING || ch >= CALIB_CH_COUNT || reference < 0.0f)
+        return false;
+
+    s_ch     = ch;
+    s_ref    = reference;
+    s_sum    = 0.0f;
+    s_cycles = 0;
+    s_state  = CALIB_RUNNING;
+    return true;
+}
+
+void Calib_Reset(void)
+{
+    s_cal = s_defaults;
+    memset(s_havePt, 0, sizeof(s_havePt));
+    save();
+}
+
+static void finish(float raw)
+{
+    float g = s_cal.gain[s_ch];
+    float o = s_cal.offset[s_ch];
+
+    if (s_ref == 0.0f)
+    {
+        o = -g * raw;                           // zero point: offset only
+    }
+    else if (raw < RAW_MIN_V)
+    {
+        UART_TransmitPacket("CAL:NOSIGNAL");
+        s_state = CALIB_FAILED;
+        return;
+    }
+    else
+    {
+        float span = fabsf(s_ref - s_ptRef[s_ch]);
+        float big  = fmaxf(s_ref, s_ptRef[s_ch]);
+
+        if (s_havePt[s_ch] && span >= CALIB_MIN_SPAN * big &&
+            fabsf(raw - s_ptRaw[s_ch]) > RAW_MIN_V)
+        {
+            g = (s_ref - s_ptRef[s_ch]) / (raw - s_ptRaw[s_ch]);
+            o = s_ref - g * raw;
+        }
+        else
+        {
+            g = (s_ref - o) / raw;
+        }
+    }
+
+    s_havePt[s_ch] = true;
+    s_ptRaw[s_ch]  = raw;
+    s_ptRef[s_ch]  = s_ref;
+
+    s_cal.gain[s_ch]   = g;
+    s_cal.offset[s_ch] = o;
+    save();
+
+    char line[40];
+    snprintf(line, sizeof(line), "CAL:%c:%.3f:%.3f",
+             (s_ch == CALIB_CH_V) ? 'V' : 'I', g, o);
+    UART_TransmitPacket(line);
+
+    s_state = CALIB_DONE;
+}
+
+void Calib_OnCycle(float rawV, float rawI)
+{
+    if (s_state != CALIB_RUNNING)
+        return;
+
+    s_sum += (s_ch == CALIB_CH_V) ? rawV : rawI;
+
+    if (++s_cycles >= CALIB_CYCLES)
+        finish(s_sum / (float)CALIB_CYCLES);
+}
@@ -0,0 +1,187 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  DRY POWER – sensorless dry-run from the motor power signature
+ *
+ *  Fed once per mains cycle from ACS712_Update. The baseline is
+ *  the unit's own normal running power, so the detector needs no
+ *  pump rating; until one is learned it stays UNKNOWN and the
+ *  sump probe alone decides.
+ ***************************************************************/
+
+#include "drypower.h"
+#include "model_handle.h"
+#include "eeprom_i2c.h"
+#include "stm32f1xx_hal.h"
+#include <math.h>
+
+#define DRYPOWER_SIGNATURE   0xD7A1
+
+typedef struct {
+    float    baseW;
+    float    basePf;
+    uint8_t  learned;
+    uint8_t  fracPct;
+    uint16_t nCycles;
+} DryPowerRecord;
+
+static DryPowerStats st = {
+    .fracPct = DRYPOWER_DEFAULT_FRAC,
+    .nCycles = DRYPOWER_DEFAULT_CYCLES
+};
+
+static bool     s_probeWet = false;
+static bool     s_wasOn    = false;
+static uint32_t s_onMs     = 0;
+static uint16_t s_lowRun   = 0;     // consecutive cycles below threshold
+static uint16_t s_okRun    = 0;     // ... at or above it
+
+static uint16_t s_learnN;
+static float    s_learnW, s_learnPf;
+
+static void save(void)
+{
+    DryPowerRecord r;
+    r.baseW   = st.baseW;
+    r.basePf  = st.basePf;
+    r.learned = st.learned;
+    r.fracPct = st.fracPct;
+    r.nCycles = st.nCycles;
+    EEPROM_WriteRecord(EE_ADDR_DRYPOWER, &r, sizeof(r), DRYPOWER_SIGNATURE);
+}
+
+void DryPower_Init(void)
+{
+    DryPowerRecord r;
+
+    if (!EEPROM_ReadRecord(EE_ADDR_DRYPOWER, &r, sizeof(r), DRYPOWER_SIGNATURE))
+        return;
+    if (!isfinite(r.baseW) || !isfinite(r.basePf) || r.fracPct > 100)
+        return;
+
+    st.learned = r.learned && r.baseW >= DRYPOWER_MIN_BASE_W;
+    st.baseW   = r.baseW;
+    st.basePf  = r.basePf;
+    st.fracPct = r.fracPct;
+    st.nCycles = r.nCycles ? r.nCycles : DRYPOWER_DEFAULT_CYCLES;
+}
+
+static void learn_cycle(float w, float pf)
+{
+    /* only normal running is a valid reference */
+    if (!s_probeWet || senseOverLoad || senseOverUnderVolt)
+    {
+        s_learnN = 0;
+        s_learnW = s_learnPf = 0.0f;
+        return;
+    }
+
+    s_learnW  += w;
+    s_learnPf += pf;
+
+    if (++s_learnN < DRYPOWER_LEARN_CYCLES)
+        return;
+
+    float meanW  = s_learnW  / (float)s_learnN;
+    float meanPf = s_learnPf / (float)s_learnN;
+    s_learnN = 0;
+    s_learnW = s_learnPf = 0.0f;
+
+    if (meanW < DRYPOWER_MIN_BASE_W)
+        return;                                 // no real load, keep waiting
+
+    st.baseW    = meanW;
+    st.basePf   = meanPf;
+    st.learned  = true;
+    st.learning = false;
+    save();
+}
+
+void DryPower_OnCycle(float powerW, float apparentVA)
+{
+    uint32_t now = HAL_GetTick();
+    bool     on  = Motor_GetStatus();
+
+    if (on && !s_wasOn)
+        s_onMs = now;
+    s_wasOn = on;
+
+    if (!on || (now - s_onMs) < DRYPOWER_START_BLANK_MS)
+    {
+        s_lowRun = s_okRun = 0;
+        s_learnN = 0;
+        s_learnW = s_learnPf = 0.0f;
+        st.verdict = DRYPOWER_UNKNOWN;
+        return;
+    }
+
+    float pf = (apparentVA > 1.0f) ? (powerW / apparentVA) : 0.0f;
+    st.lastW  = powerW;
+    st.lastPf = pf;
+
+    if (!st.learned || st.learning)
+    {
+        st.learning = true;
+        learn_cycle(powerW, pf);
+        st.verdict = DRYPOWER_UNKNOWN;
+        return;
+    }
+
+    if (st.fracPct == 0)
+    {
+        st.verdict = DRYPOWER_UNKNOWN;
+        return;
+    }
+
+    /* either half of the signature: less power, or a power factor
+       fallen by the same fraction (motor near no-load) */
+    float frac  = (float)st.fracPct * 0.01f;
+    bool  lowW  = powerW < st.baseW * frac;
+    bool  lowPf = st.basePf > 0.0f && pf < st.basePf * frac;
+
+    if (lowW || lowPf)
+    {
+        s_okRun = 0;
+        if (s_lowRun < st.nCycles) s_lowRun++;
+        if (s_lowRun >= st.nCycles) st.verdict = DRYPOWER_DRY;
+    }
+    else
+    {
+        s_lowRun = 0;
+        if (s_okRun < st.nCycles) s_okRun++;
+        if (s_okRun >= st.nCycles) st.verdict = DRYPOWER_WET;
+    }
+}
+
+DryPowerVerdict DryPower_GetVerdict(void)
+{
+    return st.verdict;
+}
+
+void DryPower_Learn(void)
+{
+    st.learning = true;
+    s_learnN    = 0;
+    s_learnW    = s_learnPf = 0.0f;
+    st.verdict  = DRYPOWER_UNKNOWN;
+}
+
+void DryPower_SetThreshold(uint8_t fracPct, uint16_t nCycles)
+{
+    if (fracPct > 100) fracPct = 100;
+    if (nCycles == 0)  nCycles = DRYPOWER_DEFAULT_CYCLES;
+
+    st.fracPct = fracPct;
+    st.nCycles = nCycles;
+    s_lowRun = s_okRun = 0;
+    save();
+}
+
+void DryPower_SetProbeWet(bool wet)
+{
+    s_probeWet = wet;
+}
+
+const DryPowerStats* DryPower_GetStats(void)
+{
+    return &st;
+}
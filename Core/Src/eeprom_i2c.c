@@ -1,12 +1,17 @@
 #include "eeprom_i2c.h"
 #include "stm32f1xx_hal.h"
+#include "lcd_i2c.h"
+#include <string.h>
 
 extern I2C_HandleTypeDef hi2c2;
 
 #define EEPROM_ADDR  (0x50 << 1)  // adjust for A0/A1/A2 pins
 
+/* I2C2 is shared with the LCD DMA transport: let it drain first */
+
 HAL_StatusTypeDef EEPROM_WriteByte(uint16_t memAddr, uint8_t data)
 {
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);
     return HAL_I2C_Mem_Write(&hi2c2, EEPROM_ADDR,
                              memAddr, I2C_MEMADD_SIZE_16BIT,
                              &data, 1, 10);
@@ -14,6 +19,7 @@ HAL_StatusTypeDef EEPROM_WriteByte(uint16_t memAddr, uint8_t data)
 
 HAL_StatusTypeDef EEPROM_ReadByte(uint16_t memAddr, uint8_t* data)
 {
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);
     return HAL_I2C_Mem_Read(&hi2c2, EEPROM_ADDR,
                             memAddr, I2C_MEMADD_SIZE_16BIT,
                             data, 1, 10);
@@ -21,6 +27,7 @@ HAL_StatusTypeDef EEPROM_ReadByte(uint16_t memAddr, uint8_t* data)
 
 HAL_StatusTypeDef EEPROM_WriteBuffer(uint16_t memAddr, uint8_t* buf, uint16_t len)
 {
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);
     return HAL_I2C_Mem_Write(&hi2c2, EEPROM_ADDR,
                              memAddr, I2C_MEMADD_SIZE_16BIT,
                              buf, len, 50);
@@ -28,7 +35,56 @@ HAL_StatusTypeDef EEPROM_WriteBuffer(uint16_t memAddr, uint8_t* buf, uint16_t le
 
 HAL_StatusTypeDef EEPROM_ReadBuffer(uint16_t memAddr, uint8_t* buf, uint16_t len)
 {
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);
     return HAL_I2C_Mem_Read(&hi2c2, EEPROM_ADDR,
                             memAddr, I2C_MEMADD_SIZE_16BIT,
                             buf, len, 50);
 }
+
+/* ============================================================
+   SELF-CHECKED RECORDS
+   ============================================================ */
+
+static uint16_t record_check(const uint8_t *p, uint16_t n, uint16_t seed)
+{
+    uint16_t sum = seed;
+
+    for (uint16_t i = 0; i < n; i++)
+        sum = (uint16_t)((sum << 1) | (sum >> 15)) ^ p[i];
+    return sum;
+}
+
+HAL_StatusTypeDef EEPROM_WriteRecord(uint16_t memAddr, const void *payload, uint16_t len, uint16_t sig)
+{
+    uint8_t  buf[EE_RECORD_MAX];
+    uint16_t check;
+
+    if (len + 4U > sizeof(buf))
+        return HAL_ERROR;
+
+    memcpy(buf, payload, len);
+    memcpy(&buf[len], &sig, 2);
+    check = record_check(buf, len + 2U, sig);
+    memcpy(&buf[len + 2U], &check, 2);
+
+    return EEPROM_WriteBuffer(memAddr, buf, len + 4U);
+}
+
+bool EEPROM_ReadRecord(uint16_t memAddr, void *payload, uint16_t len, uint16_t sig)
+{
+    uint8_t  buf[EE_RECORD_MAX];
+    uint16_t s, check;
+
+    if (len + 4U > sizeof(buf))
+        return false;
+    if (EEPROM_ReadBuffer(memAddr, buf, len + 4U) != HAL_OK)
+        return false;
+
+    memcpy(&s, &buf[len], 2);
+    memcpy(&check, &buf[len + 2U], 2);
+    if (s != sig || check != record_check(buf, len + 2U, sig))
+        return false;
+
+    memcpy(payload, buf, len);
+    return true;
+}
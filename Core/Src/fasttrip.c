@@ -0,0 +1,222 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  FAST-TRIP – ADC analog watchdog overcurrent cut-off
+ *
+ *  The AWD compares every conversion of the ACS712 channel in
+ *  hardware, so a trip costs no CPU until it fires. Relay 1 is
+ *  dropped inside the IRQ; the model FSM only learns about it
+ *  on its next 5 ms pass (FastTrip_TakeTrip) and locks out.
+ ***************************************************************/
+
+#include "fasttrip.h"
+#include "acs712.h"
+#include "adc_scan.h"
+#include "relay.h"
+#include "model_handle.h"
+#include "main.h"
+
+extern ADC_HandleTypeDef hadc1;
+extern ADC_HandleTypeDef hadc2;
+
+/* End of the I conversion after the TIM3 trigger, in CPU cycles:
+   (rank + 1) x (71.5 + 12.5) ADC clocks x ADC prescaler 6.
+   TIM3 runs at SYSCLK, so its CNT is directly comparable.   */
+#define CONV_CYC               (84U * 6U)
+#define I_END_SEQ_CYC          (2U * CONV_CYC)     // rank 2 on ADC1
+#define I_END_DUAL_CYC         (1U * CONV_CYC)     // rank 1 on ADC2
+
+static FastTripStats st = { .enabled = FASTTRIP_ENABLED_DEFAULT };
+
+static ADC_HandleTypeDef * volatile s_armedAdc = NULL;
+static volatile uint32_t s_iEndCyc   = I_END_SEQ_CYC;
+static volatile bool     s_tripped   = false;   // latched until the motor is off
+static volatile bool     s_tripEvent = false;   // consumed by the model FSM
+
+static volatile uint32_t s_armCyc = 0;      // DWT at arming, caps the look-back
+
+static bool     s_wasOn = false;
+static uint32_t s_onMs  = 0;
+
+static void awd_disarm(void)
+{
+    ADC_AnalogWDGConfTypeDef cfg = {0};
+    ADC_HandleTypeDef *h = s_armedAdc;
+
+    if (!h)
+        return;
+
+    s_armedAdc = NULL;
+    cfg.WatchdogMode = ADC_ANALOGWATCHDOG_NONE;
+    cfg.ITMode       = DISABLE;
+    HAL_ADC_AnalogWDGConfig(h, &cfg);
+    st.armed = false;
+}
+
+/* Thresholds first with the IRQ off, stale flag cleared, then IRQ on */
+static void awd_arm(ADC_HandleTypeDef *h, uint16_t hi, uint16_t lo)
+{
+    ADC_AnalogWDGConfTypeDef cfg = {0};
+
+    cfg.WatchdogMode  = ADC_ANALOGWATCHDOG_SINGLE_REG;
+    cfg.Channel       = ACS712_ADC_CHANNEL;
+    cfg.ITMode        = DISABLE;
+    cfg.HighThreshold = hi;
+    cfg.LowThreshold  = lo;
+    HAL_ADC_AnalogWDGConfig(h, &cfg);
+
+    s_iEndCyc = (h == &hadc2) ? I_END_DUAL_CYC : I_END_SEQ_CYC;
+    s_armCyc  = DWT->CYCCNT;
+    __HAL_ADC_CLEAR_FLAG(h, ADC_FLAG_AWD);
+    s_armedAdc = h;
+    __HAL_ADC_ENABLE_IT(h, ADC_IT_AWD);
+
+    st.highCounts = hi;
+    st.lowCounts  = lo;
+    st.armed      = true;
+}
+
+void FastTrip_Task(void)
+{
+    uint32_t now = HAL_GetTick();
+    bool     on  = Motor_GetStatus();
+
+    if (on && !s_wasOn)
+        s_onMs = now;
+    s_wasOn = on;
+
+    if (!on)
+        s_tripped = false;
+
+    bool want = st.enabled && on && !s_tripped
+             && sys.overload > 0.1f
+             && (now - s_onMs) >= FASTTRIP_START_BLANK_MS;
+
+    if (!want)
+    {
+        awd_disarm();
+        return;
+    }
+
+    /* peak window around the live zero offset, in ADC counts;
+       the multiple shrinks to the sensor headroom, down to the
+       minimum, before the rails clamp it */
+    float   apc  = ACS712_AmpsPerCount();
+    int32_t zero = ACS712_GetZeroCounts();
+    int32_t room = (4094 - zero < zero - 1) ? (4094 - zero) : (zero - 1);
+    float   olPk = sys.overload * 1.41421f;
+    float   mult = (float)room * apc / olPk;
+
+    if (mult > FASTTRIP_LR_MULT)     mult = FASTTRIP_LR_MULT;
+    if (mult < FASTTRIP_LR_MULT_MIN) mult = FASTTRIP_LR_MULT_MIN;
+
+    int32_t span = (int32_t)(olPk * mult / apc);
+    int32_t hi   = zero + span;
+    int32_t lo   = zero - span;
+
+    st.clamped = (hi > 4094 || lo < 1);
+    if (hi > 4094) hi = 4094;               // > HTR must stay reachable
+    if (lo < 1)    lo = 1;
+
+    st.mult  = mult;
+    st.tripA = (float)((hi - zero < zero - lo) ? (hi - zero) : (zero - lo))
+             * apc / 1.41421f;
+
+    ADC_HandleTypeDef *h = (AdcScan_GetMode() == MAINS_ACQ_DUAL) ? &hadc2 : &hadc1;
+
+    if (st.armed && h == s_armedAdc &&
+        st.highCounts == (uint16_t)hi && st.lowCounts == (uint16_t)lo)
+        return;
+
+    awd_disarm();
+    awd_arm(h, (uint16_t)hi, (uint16_t)lo);
+}
+
+static bool out_of_window(uint16_t i)
+{
+    return i > st.highCounts || i < st.lowCounts;
+}
+
+/* End of the tripping I conversion to now. The AWD flags the first
+   out-of-window sample; if this IRQ ran late the excursion may have
+   ended or gone on, so the ring is walked back over any in-window
+   tail and then over the out-of-window run to its first sample. */
+static uint32_t trip_latency(uint32_t cnt, uint32_t now)
+{
+    const AdcScanFrame *ring = AdcScan_Ring();
+    uint32_t period = TIM3->ARR + 1U;
+    uint16_t idx    = AdcScan_NewestIFrame();
+    uint32_t lat    = (cnt >= s_iEndCyc) ? (cnt - s_iEndCyc)
+                                         : (cnt + period - s_iEndCyc);
+    uint16_t k      = 0;
+
+    while (k < ADC_SCAN_RING_FRAMES && !out_of_window(ring[idx].i))
+    {
+        idx = (uint16_t)((idx + ADC_SCAN_RING_FRAMES - 1U) % ADC_SCAN_RING_FRAMES);
+        k++;
+    }
+    while (k < ADC_SCAN_RING_FRAMES)
+    {
+        uint16_t prev = (uint16_t)((idx + ADC_SCAN_RING_FRAMES - 1U) % ADC_SCAN_RING_FRAMES);
+        if (!out_of_window(ring[prev].i))
+            break;
+        idx = prev;
+        k++;
+    }
+
+    if (k >= ADC_SCAN_RING_FRAMES - 1U)
+        return FASTTRIP_LAT_OVERFLOW;           // older than the ring
+
+    lat += (uint32_t)k * period;
+
+    /* a run that started before arming tripped at the arming */
+    if (lat > now - s_armCyc)
+        lat = now - s_armCyc;
+    return lat;
+}
+
+/* ADC1_2 IRQ, ahead of HAL_ADC_IRQHandler: relay first, books later */
+void FastTrip_IRQHandler(void)
+{
+    ADC_HandleTypeDef *h = s_armedAdc;
+
+    if (!h || !(h->Instance->CR1 & ADC_CR1_AWDIE) || !(h->Instance->SR & ADC_SR_AWD))
+        return;
+
+    Relay_Set(1, false);
+    uint32_t cnt = TIM3->CNT;
+    uint32_t now = DWT->CYCCNT;
+
+    h->Instance->CR1 &= ~ADC_CR1_AWDIE;     // one shot until re-armed
+    h->Instance->SR   = ~ADC_SR_AWD;
+
+    uint32_t lat = trip_latency(cnt, now);
+
+    st.lastLatencyCyc = lat;
+    if (lat > st.worstLatencyCyc)
+        st.worstLatencyCyc = lat;
+    st.trips++;
+
+    s_tripped   = true;
+    s_tripEvent = true;
+}
+
+bool FastTrip_TakeTrip(void)
+{
+    if (!s_tripEvent)
+        return false;
+
+    s_tripEvent = false;
+    return true;
+}
+
+void FastTrip_SetEnabled(bool on)
+{
+    st.enabled = on;
+    if (!on)
+        awd_disarm();
+}
+
+const FastTripStats* FastTrip_GetStats(void)
+{
+    return &st;
+}
@@ -0,0 +1,163 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  FAULT CAPTURE – pre/post-trigger V/I waveform ring
+ *
+ *  8 cycles x 64 pairs x 2 x int16 = 2 KB of RAM. The ring is
+ *  written block by block from the DMA IRQ; the trigger only
+ *  starts a post-trigger countdown, so the frozen ring always
+ *  ends FAULTCAP_POST_CYCLES after the fault was seen.
+ ***************************************************************/
+
+#include "faultcap.h"
+#include "acs712.h"
+#include "uart.h"
+#include "stm32f1xx_hal.h"
+#include <string.h>
+
+#define RING_PAIRS     (FAULTCAP_CYCLES * ADC_SCAN_BLOCK_FRAMES)
+#define FRAME_MAX      (5 + FAULTCAP_FRAME_PAIRS * 4 + 2)
+
+static int16_t s_ring[RING_PAIRS][2];           // [v, i]
+
+static volatile FaultCapState s_state = FAULTCAP_ARMED;
+static volatile uint16_t      s_head  = 0;      // next pair to write
+static volatile uint8_t       s_postLeft;
+static uint16_t               s_trigHead;       // s_head when triggered
+
+static FaultCapHeader s_hdr;
+static uint32_t       s_trigMs;
+
+/* dump cursor: 0 = header, 1..N = sample frames, N+1 = end */
+static bool     s_dumping = false;
+static uint16_t s_dumpFrame;
+
+void FaultCap_Block(const AdcScanFrame *f, uint16_t n)
+{
+    if (s_state == FAULTCAP_FROZEN)
+        return;
+
+    uint16_t h = s_head;
+    for (; n; n--, f++)
+    {
+        s_ring[h][0] = (int16_t)f->v - 2048;
+        s_ring[h][1] = (int16_t)f->i - 2048;
+        if (++h >= RING_PAIRS) h = 0;
+    }
+    s_head = h;
+
+    if (s_state == FAULTCAP_POST && --s_postLeft == 0)
+        s_state = FAULTCAP_FROZEN;
+}
+
+void FaultCap_Trigger(FaultCapStage stage, uint8_t cause)
+{
+    if (s_state != FAULTCAP_ARMED)
+        return;                     // keep the first fault of a burst
+
+    s_hdr.stage        = (uint8_t)stage;
+    s_hdr.cause        = cause;
+    s_hdr.vRms         = g_voltageV;
+    s_hdr.iRms         = g_currentA;
+    s_trigMs           = HAL_GetTick();
+
+    __disable_irq();
+    s_trigHead = s_head;
+    s_postLeft = FAULTCAP_POST_CYCLES;
+    s_state    = FAULTCAP_POST;
+    __enable_irq();
+}
+
+void FaultCap_Arm(void)
+{
+    if (s_dumping)
+        return;
+    s_state = FAULTCAP_ARMED;
+}
+
+FaultCapState FaultCap_GetState(void)
+{
+    return s_state;
+}
+
+bool FaultCap_StartDump(void)
+{
+    if (s_state != FAULTCAP_FROZEN || s_dumping)
+        return false;
+
+    /* frozen: s_head is the oldest pair, indices are relative to it */
+    s_hdr.pairs         = RING_PAIRS;
+    s_hdr.triggerIndex  = (uint16_t)((s_trigHead + RING_PAIRS - s_head) % RING_PAIRS);
+    s_hdr.sampleRateHz  = MAINS_SAMPLE_RATE_HZ;
+    s_hdr.voltsPerCount = ACS712_VoltsPerCount();
+    s_hdr.ampsPerCount  = ACS712_AmpsPerCount();
+    s_hdr.ageMs         = HAL_GetTick() - s_trigMs;
+
+    s_dumpFrame = 0;
+    s_dumping   = true;
+    return true;
+}
+
+static uint16_t fletcher16(const uint8_t *p, uint16_t len)
+{
+    uint16_t a = 0, b = 0;
+    while (len--)
+    {
+        a = (a + *p++) % 255;
+        b = (b + a) % 255;
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+static void send_frame(uint8_t type, uint8_t index, const void *payload, uint8_t len)
+{
+    uint8_t buf[FRAME_MAX];
+
+    buf[0] = FAULTCAP_SYNC0;
+    buf[1] = FAULTCAP_SYNC1;
+    buf[2] = type;
+    buf[3] = index;
+    buf[4] = len;
+    if (len)
+        memcpy(&buf[5], payload, len);
+
+    uint16_t ck = fletcher16(&buf[2], (uint16_t)(3 + len));
+    buf[5 + len] = (uint8_t)ck;
+    buf[6 + len] = (uint8_t)(ck >> 8);
+
+    UART_TransmitBinary(buf, (uint16_t)(7 + len));
+}
+
+/* One frame per call – keeps each UART task pass under ~6 ms */
+void FaultCap_Task(void)
+{
+    const uint16_t frames = RING_PAIRS / FAULTCAP_FRAME_PAIRS;
+
+    if (!s_dumping)
+        return;
+
+    if (s_dumpFrame == 0)
+    {
+        send_frame(FAULTCAP_FRAME_HEADER, 0, &s_hdr, sizeof(s_hdr));
+    }
+    else if (s_dumpFrame <= frames)
+    {
+        int16_t  pay[FAULTCAP_FRAME_PAIRS][2];
+        uint16_t k = (uint16_t)((s_head + (s_dumpFrame - 1U) * FAULTCAP_FRAME_PAIRS) % RING_PAIRS);
+
+        for (uint16_t n = 0; n < FAULTCAP_FRAME_PAIRS; n++)
+        {
+            pay[n][0] = s_ring[k][0];
+            pay[n][1] = s_ring[k][1];
+            if (++k >= RING_PAIRS) k = 0;
+        }
+        send_frame(FAULTCAP_FRAME_SAMPLES, (uint8_t)(s_dumpFrame - 1U), pay, sizeof(pay));
+    }
+    else
+    {
+        send_frame(FAULTCAP_FRAME_END, 0, NULL, 0);
+        s_dumping = false;
+        return;
+    }
+
+    s_dumpFrame++;
+}
@@ -0,0 +1,164 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  LCD CGRAM – on-demand custom glyphs for the 2x16 dashboard
+ *
+ *  18 patterns share 8 slots. The dashboard needs at most five
+ *  at a time (pump, bell, signal, tank, one partial bar cell),
+ *  so once they are resident a redraw is DDRAM writes only.
+ ***************************************************************/
+
+#include "lcd_cgram.h"
+#include "lcd_fb.h"
+#include "lcd_i2c.h"
+
+#define SLOT_EMPTY   0xFF
+#define CODE_BASE    0x08
+
+typedef struct {
+    uint8_t rows[8];
+    char    fallback;                   // when no slot can be freed
+} GlyphDef;
+
+static const GlyphDef s_glyphs[GLYPH_COUNT] = {
+    [GLYPH_TANK_0]   = { { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F }, '0' },
+    [GLYPH_TANK_1]   = { { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F, 0x1F }, '1' },
+    [GLYPH_TANK_2]   = { { 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F, 0x1F, 0x1F }, '2' },
+    [GLYPH_TANK_3]   = { { 0x11, 0x11, 0x11, 0x11, 0x1F, 0x1F, 0x1F, 0x1F }, '3' },
+    [GLYPH_TANK_4]   = { { 0x11, 0x11, 0x11, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F }, '4' },
+    [GLYPH_TANK_5]   = { { 0x11, 0x11, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F }, '5' },
+    [GLYPH_TANK_6]   = { { 0x11, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F }, '6' },
+
+    [GLYPH_BAR_1]    = { { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 }, ' ' },
+    [GLYPH_BAR_2]    = { { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 }, ' ' },
+    [GLYPH_BAR_3]    = { { 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C }, LCD_GLYPH_BLOCK },
+    [GLYPH_BAR_4]    = { { 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E }, LCD_GLYPH_BLOCK },
+
+    [GLYPH_PUMP_ON]  = { { 0x04, 0x04, 0x0E, 0x0E, 0x1F, 0x1F, 0x0E, 0x00 }, '*' },
+    [GLYPH_PUMP_OFF] = { { 0x04, 0x04, 0x0A, 0x0A, 0x11, 0x11, 0x0E, 0x00 }, 'o' },
+    [GLYPH_BELL]     = { { 0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0x00 }, '!' },
+
+    [GLYPH_SIG_0]    = { { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x00 }, 'x' },
+    [GLYPH_SIG_1]    = { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00 }, '1' },
+    [GLYPH_SIG_2]    = { { 0x00, 0x00, 0x00, 0x04, 0x04, 0x14, 0x14, 0x00 }, '2' },
+    [GLYPH_SIG_3]    = { { 0x00, 0x01, 0x01, 0x05, 0x05, 0x15, 0x15, 0x00 }, '3' },
+};
+
+static uint8_t  s_slotGlyph[LCD_CGRAM_SLOTS];       // LcdGlyph or SLOT_EMPTY
+static uint32_t s_slotUse[LCD_CGRAM_SLOTS];         // LRU stamp
+static uint8_t  s_pending;                          // slot bits to upload
+static uint8_t  s_fetched;                          // slot bits since last emit
+static uint32_t s_useClock;
+
+static LcdCgramStats st;
+
+void lcd_cgram_init(void)
+{
+    for (uint8_t i = 0; i < LCD_CGRAM_SLOTS; i++)
+    {
+        s_slotGlyph[i] = SLOT_EMPTY;
+        s_slotUse[i]   = 0;
+    }
+    s_pending = 0;
+    s_fetched = 0;
+}
+
+void lcd_cgram_invalidate(void)
+{
+    for (uint8_t i = 0; i < LCD_CGRAM_SLOTS; i++)
+        if (s_slotGlyph[i] != SLOT_EMPTY)
+            s_pending |= (uint8_t)(1U << i);
+}
+
+static bool slot_pinned(uint8_t i)
+{
+    return (s_fetched & (1U << i)) || lcd_fb_contains((char)(CODE_BASE + i));
+}
+
+char lcd_cgram_get(LcdGlyph g)
+{
+    if (g >= GLYPH_COUNT)
+        return ' ';
+
+    uint8_t victim = SLOT_EMPTY;
+
+    for (uint8_t i = 0; i < LCD_CGRAM_SLOTS; i++)
+    {
+        if (s_slotGlyph[i] == g)
+        {
+            victim = i;
+            st.hits++;
+            break;
+        }
+    }
+
+    if (victim == SLOT_EMPTY)
+    {
+        /* empty slot first, otherwise the oldest unpinned one */
+        for (uint8_t i = 0; i < LCD_CGRAM_SLOTS; i++)
+        {
+            if (s_slotGlyph[i] == SLOT_EMPTY)
+            {
+                victim = i;
+                break;
+            }
+            if (slot_pinned(i))
+                continue;
+            if (victim == SLOT_EMPTY || s_slotUse[i] < s_slotUse[victim])
+                victim = i;
+        }
+
+        if (victim == SLOT_EMPTY)
+        {
+            st.fallbacks++;
+            return s_glyphs[g].fallback;
+        }
+
+        s_slotGlyph[victim] = (uint8_t)g;
+        s_pending |= (uint8_t)(1U << victim);
+    }
+
+    s_slotUse[victim] = ++s_useClock;
+    s_fetched |= (uint8_t)(1U << victim);
+    return (char)(CODE_BASE + victim);
+}
+
+/* 0x40 | slot<<3 sets the CGRAM address, 8 data bytes fill the slot;
+   the fb flush that follows always starts a row with a cursor move,
+   which puts the address counter back into DDRAM */
+void lcd_cgram_emit(void)
+{
+    uint8_t sent = 0;
+
+    for (uint8_t i = 0; i < LCD_CGRAM_SLOTS && sent < LCD_CGRAM_MAX_UPLOADS; i++)
+    {
+        if (!(s_pending & (1U << i)))
+            continue;
+
+        const uint8_t *rows = s_glyphs[s_slotGlyph[i]].rows;
+
+        lcd_async_cmd((uint8_t)(0x40 | (i << 3)));
+        for (uint8_t r = 0; r < 8; r++)
+            lcd_async_data(rows[r]);
+
+        s_pending &= (uint8_t)~(1U << i);
+        sent++;
+        st.uploads++;
+    }
+
+    s_fetched = 0;
+}
+
+/* upload deferred past this flush: the slot holds stale or no data */
+char lcd_cgram_stand_in(char c)
+{
+    uint8_t i = (uint8_t)c - CODE_BASE;
+
+    if (i >= LCD_CGRAM_SLOTS || !(s_pending & (1U << i)))
+        return c;
+    return s_glyphs[s_slotGlyph[i]].fallback;
+}
+
+const LcdCgramStats* lcd_cgram_stats(void)
+{
+    return &st;
+}
@@ -0,0 +1,145 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  LCD FB – shadow framebuffer with diff flush for the 2x16 LCD
+ *
+ *  Every byte to the HD44780 through the PCF8574 is expensive,
+ *  so the common dashboard refresh (a digit or two changed)
+ *  costs a cursor move and those digits instead of 32 cells.
+ *  The diff goes out through the async DMA transport; while a
+ *  previous flush is still on the bus this one is skipped and
+ *  the next Screen_Update pass picks the changes up.
+ ***************************************************************/
+
+#include "lcd_fb.h"
+#include "lcd_i2c.h"
+#include "lcd_cgram.h"
+#include <string.h>
+
+static char s_fb[LCD_FB_ROWS][LCD_FB_COLS];        // wanted
+static char s_glass[LCD_FB_ROWS][LCD_FB_COLS];     // on the display
+static bool s_glassValid = false;
+
+static LcdFbStats st;
+
+void lcd_fb_init(void)
+{
+    memset(s_fb, ' ', sizeof(s_fb));
+    memset(s_glass, ' ', sizeof(s_glass));
+    s_glassValid = true;
+    lcd_cgram_init();
+}
+
+void lcd_fb_clear(void)
+{
+    memset(s_fb, ' ', sizeof(s_fb));
+}
+
+void lcd_fb_line(uint8_t row, const char *s)
+{
+    if (row >= LCD_FB_ROWS)
+        return;
+
+    uint8_t c = 0;
+    for (; c < LCD_FB_COLS && s && s[c]; c++)
+        s_fb[row][c] = s[c];
+    for (; c < LCD_FB_COLS; c++)
+        s_fb[row][c] = ' ';
+}
+
+void lcd_fb_putc(uint8_t row, uint8_t col, char c)
+{
+    if (row < LCD_FB_ROWS && col < LCD_FB_COLS)
+        s_fb[row][col] = c;
+}
+
+bool lcd_fb_contains(char c)
+{
+    return memchr(s_fb, c, sizeof(s_fb)) != NULL;
+}
+
+void lcd_fb_invalidate(void)
+{
+    s_glassValid = false;
+}
+
+/* what the cell may show now: a glyph still waiting for its
+   upload is drawn as its fallback and stays dirty until sent */
+static char cell(uint8_t r, uint8_t c)
+{
+    return lcd_cgram_stand_in(s_fb[r][c]);
+}
+
+uint16_t lcd_fb_flush(void)
+{
+    uint16_t sent = 0;
+
+    if (lcd_async_take_error())
+    {
+        s_glassValid = false;               // glass state unknown
+        lcd_cgram_invalidate();
+    }
+
+    if (!lcd_async_begin())
+    {
+        st.skipped++;
+        return 0;
+    }
+
+    lcd_cgram_emit();                       // glyphs before the cells using them
+
+    for (uint8_t r = 0; r < LCD_FB_ROWS; r++)
+    {
+        int8_t curCol = -1;                     // cursor unknown per row
+
+        uint8_t c = 0;
+        while (c < LCD_FB_COLS)
+        {
+            if (s_glassValid && cell(r, c) == s_glass[r][c])
+            {
+                c++;
+                continue;
+            }
+
+            /* dirty run [c, end), bridging single clean cells */
+            uint8_t end = c + 1;
+            while (end < LCD_FB_COLS)
+            {
+                if (!s_glassValid || cell(r, end) != s_glass[r][end])
+                    end++;
+                else if (end + 1 < LCD_FB_COLS && cell(r, end + 1) != s_glass[r][end + 1])
+                    end += 2;
+                else
+                    break;
+            }
+
+            if (curCol != (int8_t)c)
+            {
+                lcd_async_put_cur(r, c);
+                st.cursorMoves++;
+            }
+
+            for (; c < end; c++)
+            {
+                s_glass[r][c] = cell(r, c);
+                lcd_async_data((uint8_t)s_glass[r][c]);
+                sent++;
+            }
+            curCol = (int8_t)end;
+        }
+    }
+
+    /* a failed start redraws in full next time; a bus error
+       mid-transfer is picked up by lcd_async_take_error() */
+    s_glassValid = lcd_async_commit();
+    if (!s_glassValid)
+        lcd_cgram_invalidate();
+    st.flushes++;
+    st.charsSent   += sent;
+    st.lastChars    = sent;
+    return sent;
+}
+
+const LcdFbStats* lcd_fb_stats(void)
+{
+    return &st;
+}
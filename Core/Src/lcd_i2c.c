@@ -1,5 +1,6 @@
 #include "lcd_i2c.h"
 #include "stm32f1xx_hal.h"
+#include "profiler.h"
 
 extern I2C_HandleTypeDef hi2c2;
 
@@ -18,30 +19,64 @@ static uint8_t g_backlight = LCD_BACKLIGHT_BIT;
 
 /* ============================================================
    LOW-LEVEL EXPANDER WRITE
+   The PCF8574 latches every byte of a multi-byte write, so a
+   whole character (hi|EN, hi, lo|EN, lo) goes out as one I2C
+   transaction with one address phase. At 100 kHz the 90 us per
+   byte already exceeds the E pulse and the 37 us instruction
+   time; only clear/home need a real wait.
+   When RS changes, an RS-only byte goes first: RS and EN must
+   not rise on the same latch (tAS, RS setup before E).
    ============================================================ */
 
-static HAL_StatusTypeDef lcd_i2c_write(uint8_t data)
+#define LCD_BURST_CHARS     16        // one row per transaction
+#define LCD_EXPAND_MAX      5         // RS settle + 4
+
+static uint32_t s_busBytes;           // address + data bytes, for the bench
+static int8_t   s_rs = -1;            // RS latched by the blocking path, -1 unknown
+
+static HAL_StatusTypeDef lcd_i2c_burst(uint8_t *p, uint16_t n)
 {
-    return HAL_I2C_Master_Transmit(&hi2c2, LCD_I2C_ADDR, &data, 1, 5);
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);
+    s_busBytes += n + 1U;
+    return HAL_I2C_Master_Transmit(&hi2c2, LCD_I2C_ADDR, p, n, 2U + n / 8U);
 }
 
-static void lcd_pulse_enable(uint8_t data)
+/* one HD44780 byte as expander bytes, RS settle first if *lastRs
+   differs (both paths keep their own); returns 4 or 5          */
+static uint8_t lcd_expand(uint8_t *out, uint8_t b, uint8_t rs, int8_t *lastRs)
 {
-    lcd_i2c_write(data | LCD_ENABLE_BIT);
-    HAL_Delay(2);
-    lcd_i2c_write(data & ~LCD_ENABLE_BIT);
-    HAL_Delay(2);
+    uint8_t ctl = g_backlight | (rs ? LCD_RS_BIT : 0);
+    uint8_t hi  = (b & 0xF0) | ctl;
+    uint8_t lo  = (uint8_t)(b << 4) | ctl;
+    uint8_t n   = 0;
+
+    if (*lastRs != (int8_t)rs)
+    {
+        out[n++] = ctl;
+        *lastRs  = (int8_t)rs;
+    }
+    out[n++] = hi | LCD_ENABLE_BIT;
+    out[n++] = hi;
+    out[n++] = lo | LCD_ENABLE_BIT;
+    out[n++] = lo;
+    return n;
 }
 
+/* single nibble, 8-bit mode reset sequence only */
 static void lcd_write4(uint8_t nibble, uint8_t rs)
 {
-    uint8_t data = (nibble & 0xF0);
-
-    if (rs) data |= LCD_RS_BIT;
-    data |= g_backlight;
+    uint8_t data = (nibble & 0xF0) | g_backlight | (rs ? LCD_RS_BIT : 0);
+    uint8_t buf[3];
+    uint8_t n = 0;
 
-    lcd_i2c_write(data);
-    lcd_pulse_enable(data);
+    if (s_rs != (int8_t)rs)
+    {
+        buf[n++] = data;
+        s_rs     = (int8_t)rs;
+    }
+    buf[n++] = data | LCD_ENABLE_BIT;
+    buf[n++] = data;
+    lcd_i2c_burst(buf, n);
 }
 
 /* ============================================================
@@ -50,27 +85,32 @@ static void lcd_write4(uint8_t nibble, uint8_t rs)
 
 void lcd_send_cmd(uint8_t cmd)
 {
-    lcd_write4(cmd & 0xF0, 0);
-    lcd_write4((cmd << 4) & 0xF0, 0);
-    HAL_Delay(2);
+    uint8_t buf[LCD_EXPAND_MAX];
+
+    lcd_i2c_burst(buf, lcd_expand(buf, cmd, 0, &s_rs));
+    if (cmd <= 0x03)
+        HAL_Delay(2);                       // clear / home: 1.52 ms
 }
 
 void lcd_send_data(uint8_t data)
 {
-    lcd_write4(data & 0xF0, 1);
-    lcd_write4((data << 4) & 0xF0, 1);
+    uint8_t buf[LCD_EXPAND_MAX];
+
+    lcd_i2c_burst(buf, lcd_expand(buf, data, 1, &s_rs));
 }
 
 void lcd_backlight_on(void)
 {
     g_backlight = LCD_BACKLIGHT_BIT;
-    lcd_i2c_write(g_backlight);
+    s_rs        = 0;
+    lcd_i2c_burst(&g_backlight, 1);
 }
 
 void lcd_backlight_off(void)
 {
     g_backlight = 0;
-    lcd_i2c_write(g_backlight);
+    s_rs        = 0;
+    lcd_i2c_burst(&g_backlight, 1);
 }
 
 void lcd_clear(void)
@@ -86,9 +126,301 @@ void lcd_put_cur(uint8_t row, uint8_t col)
 }
 
 void lcd_send_string(char *str)
+{
+    uint8_t  buf[LCD_BURST_CHARS * 4 + 1];
+    uint16_t n = 0;
+
+    while (*str)
+    {
+        if (n + LCD_EXPAND_MAX > sizeof(buf))
+        {
+            lcd_i2c_burst(buf, n);
+            n = 0;
+        }
+        n += lcd_expand(&buf[n], (uint8_t)*str++, 1, &s_rs);
+    }
+    if (n)
+        lcd_i2c_burst(buf, n);
+}
+
+/* ============================================================
+   BENCHMARK: per-nibble transport vs. burst
+   The old path is kept here only as the reference: three
+   1-byte transactions per nibble with HAL_Delay(2) around the
+   E pulse.
+   ============================================================ */
+
+static void legacy_write(uint8_t data)
+{
+    s_rs        = -1;
+    s_busBytes += 2U;
+    HAL_I2C_Master_Transmit(&hi2c2, LCD_I2C_ADDR, &data, 1, 5);
+}
+
+static void legacy_write4(uint8_t nibble, uint8_t rs)
+{
+    uint8_t data = (nibble & 0xF0) | g_backlight | (rs ? LCD_RS_BIT : 0);
+
+    legacy_write(data);
+    legacy_write(data | LCD_ENABLE_BIT);
+    HAL_Delay(2);
+    legacy_write(data & ~LCD_ENABLE_BIT);
+    HAL_Delay(2);
+}
+
+static void legacy_send_string(const char *str)
+{
+    for (; *str; str++)
+    {
+        legacy_write4((uint8_t)*str & 0xF0, 1);
+        legacy_write4((uint8_t)(*str << 4) & 0xF0, 1);
+    }
+}
+
+void lcd_bench_string(const char *str, LcdBench *out)
+{
+    uint32_t t0;
+
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);
+
+    lcd_put_cur(1, 0);
+    s_busBytes = 0;
+    t0 = Prof_Begin();
+    legacy_send_string(str);
+    out->oldUs    = Prof_CyclesToUs(Prof_Begin() - t0);
+    out->oldBytes = s_busBytes;
+
+    lcd_put_cur(1, 0);
+    s_busBytes = 0;
+    t0 = Prof_Begin();
+    lcd_send_string((char*)str);
+    out->newUs    = Prof_CyclesToUs(Prof_Begin() - t0);
+    out->newBytes = s_busBytes;
+}
+
+/* ============================================================
+   ASYNC TRANSPORT (I2C2 TX DMA)
+   Same expansion (and RS settle) as the burst path, for a whole
+   update at once. Only clear/home (1.52 ms) end a segment;
+   the next segment starts from SysTick once LCD_ASYNC_SLOW_MS
+   has passed.
+   ============================================================ */
+
+typedef enum {
+    ASYNC_IDLE = 0,
+    ASYNC_XFER,                 // DMA segment on the bus
+    ASYNC_WAIT                  // clear/home settling, SysTick resumes
+} AsyncState;
+
+typedef struct {
+    uint16_t start;
+    uint16_t len;
+    uint8_t  waitMs;            // after this segment
+} AsyncSeg;
+
+static uint8_t  s_buf[LCD_ASYNC_BUF];
+static AsyncSeg s_seg[LCD_ASYNC_SEGS];
+static uint16_t s_len;
+static uint16_t s_segStart;
+static uint8_t  s_nSeg;
+static bool     s_overflow;
+static int8_t   s_lastRs;
+
+static volatile AsyncState s_state = ASYNC_IDLE;
+static volatile uint8_t    s_cur;
+static volatile uint8_t    s_waitLeft;
+static volatile bool       s_error;
+
+static LcdAsyncStats ast;
+
+static void seg_close(uint8_t waitMs)
+{
+    if (s_len == s_segStart)
+    {
+        /* empty: fold the wait into the previous segment */
+        if (waitMs && s_nSeg)
+            s_seg[s_nSeg - 1].waitMs = waitMs;
+        return;
+    }
+
+    if (s_nSeg >= LCD_ASYNC_SEGS)
+    {
+        s_overflow = true;
+        return;
+    }
+
+    s_seg[s_nSeg].start  = s_segStart;
+    s_seg[s_nSeg].len    = (uint16_t)(s_len - s_segStart);
+    s_seg[s_nSeg].waitMs = waitMs;
+    s_nSeg++;
+    s_segStart = s_len;
+}
+
+static void async_put(uint8_t b, uint8_t rs)
+{
+    uint8_t n = (s_lastRs != (int8_t)rs) ? 5 : 4;
+
+    if (s_len + n > LCD_ASYNC_BUF)
+    {
+        s_overflow = true;
+        return;
+    }
+
+    s_len += lcd_expand(&s_buf[s_len], b, rs, &s_lastRs);
+}
+
+/* state goes to XFER before the start: the DMA IRQ may beat us back */
+static bool seg_start(uint8_t i)
+{
+    s_cur   = i;
+    s_state = ASYNC_XFER;
+    if (HAL_I2C_Master_Transmit_DMA(&hi2c2, LCD_I2C_ADDR,
+                                    &s_buf[s_seg[i].start], s_seg[i].len) == HAL_OK)
+        return true;
+
+    s_error = true;
+    ast.errors++;
+    s_state = ASYNC_IDLE;
+    return false;
+}
+
+static void seg_done(void)
+{
+    uint8_t i = s_cur;
+
+    if (s_seg[i].waitMs)
+    {
+        s_waitLeft = (uint8_t)(s_seg[i].waitMs + 1);  // tick phase unknown
+        s_state    = ASYNC_WAIT;
+        return;
+    }
+
+    if (i + 1 < s_nSeg)
+        seg_start(i + 1);
+    else
+        s_state = ASYNC_IDLE;
+}
+
+bool lcd_async_busy(void)
+{
+    return s_state != ASYNC_IDLE;
+}
+
+bool lcd_async_begin(void)
+{
+    if (s_state != ASYNC_IDLE)
+        return false;
+
+    s_len          = 0;
+    s_nSeg         = 0;
+    s_segStart     = 0;
+    s_overflow     = false;
+    s_lastRs       = -1;
+    return true;
+}
+
+void lcd_async_cmd(uint8_t cmd)
+{
+    async_put(cmd, 0);
+    if (cmd == 0x01 || (cmd & 0xFE) == 0x02)
+        seg_close(LCD_ASYNC_SLOW_MS);       // clear / home
+}
+
+void lcd_async_data(uint8_t data)
+{
+    async_put(data, 1);
+}
+
+void lcd_async_put_cur(uint8_t row, uint8_t col)
+{
+    lcd_async_cmd((uint8_t)((row == 0 ? 0x80 : 0xC0) + col));
+}
+
+void lcd_async_string(const char *str)
 {
     while (*str)
-        lcd_send_data(*str++);
+        async_put((uint8_t)*str++, 1);
+}
+
+bool lcd_async_commit(void)
+{
+    seg_close(0);
+
+    if (s_overflow)
+    {
+        ast.overflows++;
+        return false;
+    }
+    if (s_nSeg == 0)
+        return true;                        // nothing to send
+
+    ast.commits++;
+    ast.bytes    += s_len;
+    ast.lastBytes = s_len;
+    s_rs          = -1;                     // blocking path: RS after DMA unknown
+
+    return seg_start(0);
+}
+
+bool lcd_async_wait_idle(uint32_t timeoutMs)
+{
+    uint32_t t0 = HAL_GetTick();
+
+    while (s_state != ASYNC_IDLE)
+    {
+        if (HAL_GetTick() - t0 >= timeoutMs)
+        {
+            if (s_state == ASYNC_XFER)
+                HAL_I2C_Master_Abort_IT(&hi2c2, LCD_I2C_ADDR);
+            s_state = ASYNC_IDLE;
+            s_error = true;
+            ast.errors++;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool lcd_async_take_error(void)
+{
+    if (!s_error)
+        return false;
+
+    s_error = false;
+    return true;
+}
+
+/* SysTick, 1 kHz */
+void lcd_async_tick(void)
+{
+    if (s_state != ASYNC_WAIT || --s_waitLeft)
+        return;
+
+    if (s_cur + 1 < s_nSeg)
+        seg_start(s_cur + 1);
+    else
+        s_state = ASYNC_IDLE;
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c == &hi2c2 && s_state == ASYNC_XFER)
+        seg_done();
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != &hi2c2 || s_state == ASYNC_IDLE)
+        return;
+
+    s_error = true;
+    ast.errors++;
+    s_state = ASYNC_IDLE;
+}
+
+const LcdAsyncStats* lcd_async_stats(void)
+{
+    return &ast;
 }
 
 /* ============================================================
@@ -0,0 +1,243 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  LEVEL – tank level from probes, a resistor ladder or a
+ *          pressure transducer
+ *
+ *  Every source answers the same questions (steps, %, full),
+ *  so show_dash, UART_SendStatusPacket and isTankFull never
+ *  look at probe voltages themselves.
+ ***************************************************************/
+
+#include "level.h"
+#include "adc.h"
+#include "pressure_level.h"
+#include "eeprom_i2c.h"
+#include <string.h>
+
+#define LEVEL_SIGNATURE   0x1E7E
+
+typedef struct {
+    uint8_t        source;
+    uint8_t        reserved;
+    LevelLadderCfg ladder;
+} LevelRecord;
+
+extern ADC_Data adcData;
+
+static LevelSource    s_src = LEVEL_SRC_PROBES;
+static LevelLadderCfg s_ladder;
+static uint8_t        s_submerged = 0;
+
+/* ladder decoder */
+static bool     s_valid = false;    // false until the first decode
+static uint8_t  s_cand  = 0;
+static uint8_t  s_dwell = 0;
+
+/* uncalibrated ladder: 3.0 V dry, 0.2 V all submerged, even steps */
+static void ladder_defaults(uint8_t steps)
+{
+    const int32_t top = 3723, bottom = 248;
+
+    memset(&s_ladder, 0, sizeof(s_ladder));
+    s_ladder.steps = steps;
+    s_ladder.hyst  = LEVEL_LADDER_HYST;
+    for (uint8_t k = 0; k <= steps; k++)
+        s_ladder.center[k] = (uint16_t)(top - (top - bottom) * k / steps);
+}
+
+static void save(void)
+{
+    LevelRecord r;
+
+    memset(&r, 0, sizeof(r));
+    r.source = (uint8_t)s_src;
+    r.ladder = s_ladder;
+    EEPROM_WriteRecord(EE_ADDR_LEVEL, &r, sizeof(r), LEVEL_SIGNATURE);
+}
+
+void Level_Init(void)
+{
+    LevelRecord r;
+
+    ladder_defaults(LEVEL_PROBE_STEPS);
+
+    if (!EEPROM_ReadRecord(EE_ADDR_LEVEL, &r, sizeof(r), LEVEL_SIGNATURE))
+        return;
+    if (r.ladder.steps < 1 || r.ladder.steps > LEVEL_LADDER_MAX)
+        return;
+
+    s_src    = (r.source <= LEVEL_SRC_PRESSURE) ? (LevelSource)r.source : LEVEL_SRC_PROBES;
+    s_ladder = r.ladder;
+}
+
+/* boundary between k-1 and k submerged, centres in either order */
+static inline int32_t edge(uint8_t k)
+{
+    return ((int32_t)s_ladder.center[k - 1] + s_ladder.center[k]) / 2;
+}
+
+static uint8_t ladder_band(int32_t v)
+{
+    bool    falling = s_ladder.center[s_ladder.steps] < s_ladder.center[0];
+    uint8_t k       = 0;
+
+    while (k < s_ladder.steps &&
+           (falling ? (v < edge(k + 1)) : (v >= edge(k + 1))))
+        k++;
+    return k;
+}
+
+/* leave the current band only past its boundary + hyst */
+static bool outside_band(int32_t v, uint8_t k)
+{
+    bool    falling = s_ladder.center[s_ladder.steps] < s_ladder.center[0];
+    int32_t h       = s_ladder.hyst;
+    int32_t s       = falling ? -1 : 1;         // fold to a rising ladder
+
+    if (k > 0 && s * v < s * edge(k) - h)
+        return true;
+    if (k < s_ladder.steps && s * v >= s * edge(k + 1) + h)
+        return true;
+    return false;
+}
+
+static void ladder_update(void)
+{
+    int32_t raw = ADC_GetFilteredCounts(LEVEL_LADDER_PROBE);
+
+    if (!s_valid)
+    {
+        s_submerged = ladder_band(raw);
+        s_valid     = true;
+        return;
+    }
+
+    if (!outside_band(raw, s_submerged))
+    {
+        s_dwell = 0;
+        return;
+    }
+
+    uint8_t k = ladder_band(raw);
+    if (k != s_cand)
+    {
+        s_cand  = k;
+        s_dwell = 0;
+    }
+    if (++s_dwell >= LEVEL_LADDER_DWELL)
+    {
+        s_submerged = k;
+        s_dwell     = 0;
+    }
+}
+
+void Level_Update(void)
+{
+    if (s_src == LEVEL_SRC_LADDER)
+    {
+        ladder_update();
+        return;
+    }
+    if (s_src == LEVEL_SRC_PRESSURE)
+    {
+        PLevel_Update();
+        s_submerged = (uint8_t)(PLevel_GetPercent() * LEVEL_PROBE_STEPS / 100U);
+        return;
+    }
+
+    uint8_t n = 0;
+    for (uint8_t i = 1; i <= LEVEL_PROBE_STEPS; i++)
+        if (adcData.voltages[i] < LEVEL_PROBE_WET_V) n++;
+    s_submerged = n;
+}
+
+LevelSource Level_GetSource(void)
+{
+    return s_src;
+}
+
+uint8_t Level_GetSubmerged(void)
+{
+    return s_submerged;
+}
+
+uint8_t Level_GetSteps(void)
+{
+    return (s_src == LEVEL_SRC_LADDER) ? s_ladder.steps : LEVEL_PROBE_STEPS;
+}
+
+uint8_t Level_GetPercent(void)
+{
+    if (s_src == LEVEL_SRC_PRESSURE)
+        return PLevel_GetPercent();
+    return (uint8_t)((uint16_t)s_submerged * 100U / Level_GetSteps());
+}
+
+bool Level_IsFull(void)
+{
+    if (s_src == LEVEL_SRC_PRESSURE)
+        return PLevel_IsFull();
+    return s_submerged >= Level_GetSteps();
+}
+
+bool Level_IsFault(void)
+{
+    return s_src == LEVEL_SRC_PRESSURE && !PLevel_IsValid();
+}
+
+bool Level_IsContinuous(void)
+{
+    return s_src == LEVEL_SRC_PRESSURE && PLevel_IsValid();
+}
+
+uint16_t Level_GetMm(void)
+{
+    return Level_IsContinuous() ? PLevel_GetMm() : 0;
+}
+
+void Level_SetSource(LevelSource src)
+{
+    s_src       = src;
+    s_valid     = false;
+    s_dwell     = 0;
+    s_submerged = 0;
+    save();
+}
+
+bool Level_SetLadderSteps(uint8_t steps)
+{
+    if (steps < 1 || steps > LEVEL_LADDER_MAX)
+        return false;
+
+    ladder_defaults(steps);
+    s_valid = false;
+    save();
+    return true;
+}
+
+bool Level_CalibrateBand(uint8_t k)
+{
+    if (k > s_ladder.steps)
+        return false;
+
+    s_ladder.center[k] = ADC_GetFilteredCounts(LEVEL_LADDER_PROBE);
+    s_valid = false;
+    save();
+    return true;
+}
+
+void Level_SetHysteresis(uint16_t counts)
+{
+    s_ladder.hyst = counts;
+    save();
+}
+
+const LevelLadderCfg* Level_GetLadder(void)
+{
+    return &s_ladder;
+}
+
+uint16_t Level_GetLadderRaw(void)
+{
+    return ADC_GetFilteredCounts(LEVEL_LADDER_PROBE);
+}
@@ -14,6 +14,9 @@ uint8_t txBuffer[64];
 uint32_t txPacketCount = 0;
 uint32_t rxPacketCount = 0;
 
+static int16_t  s_lastRssi;
+static uint32_t s_lastRxMs;
+
 // NSS control
 #define NSS_LOW()   HAL_GPIO_WritePin(LORA_NSS_PORT, LORA_NSS_PIN, GPIO_PIN_RESET)
 #define NSS_HIGH()  HAL_GPIO_WritePin(LORA_NSS_PORT, LORA_NSS_PIN, GPIO_PIN_SET)
@@ -181,6 +184,9 @@ uint8_t LoRa_ReceivePacket(uint8_t *buffer, int16_t *rssi)
         int16_t raw_rssi = LoRa_ReadReg(0x1A);
         *rssi = -157 + raw_rssi;
 
+        s_lastRssi = *rssi;
+        s_lastRxMs = HAL_GetTick();
+
         LoRa_WriteReg(0x12, 0xFF);
         return len;
     }
@@ -188,6 +194,20 @@ uint8_t LoRa_ReceivePacket(uint8_t *buffer, int16_t *rssi)
     return 0;
 }
 
+/* ----------------------------------------------------------
+   LINK QUALITY (0..3 bars from the last packet's RSSI)
+---------------------------------------------------------- */
+uint8_t LoRa_GetLinkBars(void)
+{
+    if (rxPacketCount == 0 || HAL_GetTick() - s_lastRxMs > LORA_LINK_STALE_MS)
+        return 0;
+
+    if (s_lastRssi >= -80)  return 3;
+    if (s_lastRssi >= -100) return 2;
+    if (s_lastRssi >= -115) return 1;
+    return 0;
+}
+
 /* ----------------------------------------------------------
    MAIN LORA TASK
 ---------------------------------------------------------- */
@@ -22,6 +22,7 @@
 #include "adc.h"
 #include "lora.h"
 #include "uart.h"
+#include "uart_commands.h"
 #include "model_handle.h"
 #include "screen.h"
 #include "led.h"
@@ -33,6 +34,18 @@
 #include "stdio.h"
 
 #include "acs712.h"
+#include "adc_scan.h"
+#include "fasttrip.h"
+#include "faultcap.h"
+#include "calib.h"
+#include "drypower.h"
+#include "startprof.h"
+#include "level.h"
+#include "pressure_level.h"
+#include "powerq.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "meter.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -60,8 +73,11 @@ extern float g_voltageV;
 
 /* Private variables ---------------------------------------------------------*/
 ADC_HandleTypeDef hadc1;
+ADC_HandleTypeDef hadc2;
+DMA_HandleTypeDef hdma_adc1;
 
 I2C_HandleTypeDef hi2c2;
+DMA_HandleTypeDef hdma_i2c2_tx;
 
 RTC_HandleTypeDef hrtc;
 
@@ -83,7 +99,9 @@ extern uint8_t loraMode;
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_ADC1_Init(void);
+static void MX_ADC2_Init(void);
 //static void MX_RTC_Init(void);
 static void MX_SPI1_Init(void);
 static void MX_USART1_UART_Init(void);
@@ -103,14 +121,101 @@ void Debug_Print(char *msg) {
 /* USER CODE BEGIN 0 */
 
 
+/* TIM3-triggered 8-rank scan: each half of the DMA buffer is one block */
 void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
 {
     if (hadc->Instance == ADC1)
     {
-        // Optional: handle mid-buffer events (for faster updates)
+        PROF_RUN(PROF_ADC_BLOCK, AdcScan_BlockReady(0));
     }
 }
 
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    if (hadc->Instance == ADC1)
+    {
+        PROF_RUN(PROF_ADC_BLOCK, AdcScan_BlockReady(1));
+    }
+}
+
+/* ===================== SCHEDULED TASKS ===================== */
+
+/* Motor protections + mode FSMs (load/volt fault, dry-run, max-run) */
+static void task_protect(void)
+{
+    FastTrip_Task();
+    PROF_RUN(PROF_MODEL_PROCESS,  ModelHandle_Process());
+    PROF_RUN(PROF_DRYRUN_PROCESS, ModelHandle_ProcessDryRun());
+}
+
+/* Mains V/I measurement (ZMPT101B + ACS712) + energy metering */
+static void task_mains(void)
+{
+    PROF_RUN(PROF_ACS712_UPDATE, ACS712_Update());
+    Meter_Task();
+}
+
+/* Water-level / dry-run probes */
+static void task_probes(void)
+{
+    PROF_RUN(PROF_ADC_READ, ADC_ReadAllChannels(&adcData));
+    Level_Update();
+}
+
+static void task_switches(void)
+{
+    PROF_RUN(PROF_SWITCHES, Screen_HandleSwitches());
+}
+
+static void task_uart(void)
+{
+    if (UART_GetReceivedPacket(receivedUartPacket, sizeof(receivedUartPacket)))
+    {
+        UART_HandleCommand(receivedUartPacket);
+        g_screenUpdatePending = true;
+    }
+    FaultCap_Task();             // one binary frame per pass while dumping
+    PowerQ_Task();               // PQ log: EEPROM append / one dump line
+}
+
+static void task_lora(void)
+{
+    PROF_RUN(PROF_LORA_TASK, LoRa_Task());
+    ADC_ReportProbeEvents();     // probe edges queued by task_probes
+}
+
+static void task_led(void)
+{
+    PROF_RUN(PROF_LED_TASK, LED_Task());
+}
+
+static void task_lcd(void)
+{
+    PROF_RUN(PROF_SCREEN_UPDATE, Screen_Update());
+}
+
+/* RTC read + timer-slot engine (minute resolution, 1 Hz is plenty) */
+static void task_rtc(void)
+{
+    PROF_RUN(PROF_RTC_READ, RTC_GetTimeDate());
+    ModelHandle_TimerRecalculateNow();
+    ModelHandle_CheckAutoTimerActivation();
+}
+
+/*                      name       fn             period deadline prio */
+static const SchedTask appTasks[] = {
+    { "PROTECT", task_protect,      5,     5,     0 },
+    { "MAINS",   task_mains,       20,    20,     1 },
+    { "PROBES",  task_probes,      20,    20,     1 },
+    { "SWITCH",  task_switches,    10,    10,     2 },
+    { "UART",    task_uart,        10,    20,     2 },
+    { "LED",     task_led,         10,    20,     3 },
+    { "LORA",    task_lora,        50,    50,     3 },
+    { "LCD",     task_lcd,        100,   100,     4 },
+    { "RTC",     task_rtc,       1000,   200,     4 },
+};
+#define APP_TASK_COUNT  (sizeof(appTasks) / sizeof(appTasks[0]))
+
 
 /* USER CODE END 0 */
 
@@ -125,13 +230,16 @@ int main(void)
 
     HAL_Init();
     SystemClock_Config();
+    Prof_Init();                 // DWT cycle counter for @PROF#
 
     /* ===== POWER-UP REFERENCE (for 7s motor lockout) ===== */
     ModelHandle_OnPowerUp();     // <-- NEW
 
     /* Initialize HAL peripherals */
     MX_GPIO_Init();
+    MX_DMA_Init();
     MX_ADC1_Init();
+    MX_ADC2_Init();
     MX_SPI1_Init();
     MX_USART1_UART_Init();
     MX_I2C2_Init();              // MUST COME BEFORE ANY I2C DEVICE
@@ -166,51 +274,26 @@ int main(void)
     Switches_Init();
     Relay_Init();
     LED_Init();
-    ACS712_Init(&hadc1);
+    Calib_Init();                // V/I gain + offset from EEPROM
+    DryPower_Init();             // dry-run power baseline
+    StartProf_Init();            // motor start baseline
+    Level_Init();                // probes / resistor ladder / transducer
+    PLevel_Init();
+    ACS712_Init();
+    Meter_Init();
+    PowerQ_Init();               // PQ log head + POWERUP event (needs RTC)
 
     loraMode = LORA_MODE_RECEIVER;
 
+    /* Protections 5 ms, sensing 20 ms (one mains cycle), LCD 10 Hz, RTC 1 Hz */
+    Scheduler_Init(appTasks, APP_TASK_COUNT);
+
     /* USER CODE END 2 */
 
     /* Infinite loop */
     while (1)
     {
-
-        /* == Sensor Updates == */
-        ACS712_Update();
-        ADC_ReadAllChannels(&hadc1, &adcData);
-
-        /* == UI Buttons + Screen == */
-        Screen_HandleSwitches();
-        Screen_Update();
-
-        /* == Update RTC time == */
-        RTC_GetTimeDate();
-
-        /* == Recalculate timer engine == */
-        ModelHandle_TimerRecalculateNow();
-
-        /* == Auto Timer Activation == */
-        ModelHandle_CheckAutoTimerActivation();
-
-        /* == UART Commands == */
-        if (UART_GetReceivedPacket(receivedUartPacket, sizeof(receivedUartPacket)))
-        {
-            UART_HandleCommand(receivedUartPacket);
-            g_screenUpdatePending = true;
-        }
-
-        /* == Core Motor Logic == */
-        ModelHandle_Process();
-        ModelHandle_ProcessDryRun();
-
-        /* == LoRa Communication == */
-        LoRa_Task();
-
-        /* == LED Updates == */
-        LED_Task();
-
-        HAL_Delay(10);  // ~50Hz loop
+        Scheduler_RunOnce();
     }
 
     /* USER CODE BEGIN 3 */
@@ -284,12 +367,12 @@ static void MX_ADC1_Init(void)
   /** Common config
   */
   hadc1.Instance = ADC1;
-  hadc1.Init.ScanConvMode = ADC_SCAN_DISABLE;
+  hadc1.Init.ScanConvMode = ADC_SCAN_ENABLE;
   hadc1.Init.ContinuousConvMode = DISABLE;
   hadc1.Init.DiscontinuousConvMode = DISABLE;
-  hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+  hadc1.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T3_TRGO;
   hadc1.Init.DataAlign = ADC_DATAALIGN_RIGHT;
-  hadc1.Init.NbrOfConversion = 8;
+  hadc1.Init.NbrOfConversion = 2;
   if (HAL_ADC_Init(&hadc1) != HAL_OK)
   {
     Error_Handler();
@@ -297,9 +380,9 @@ static void MX_ADC1_Init(void)
 
   /** Configure Regular Channel
   */
-  sConfig.Channel = ADC_CHANNEL_0;
+  sConfig.Channel = ADC_CHANNEL_6;
   sConfig.Rank = ADC_REGULAR_RANK_1;
-  sConfig.SamplingTime = ADC_SAMPLETIME_1CYCLE_5;
+  sConfig.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
   if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
   {
     Error_Handler();
@@ -307,69 +390,63 @@ static void MX_ADC1_Init(void)
 
   /** Configure Regular Channel
   */
-  sConfig.Channel = ADC_CHANNEL_1;
+  sConfig.Channel = ADC_CHANNEL_7;
   sConfig.Rank = ADC_REGULAR_RANK_2;
   if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
   {
     Error_Handler();
   }
+  /* USER CODE BEGIN ADC1_Init 2 */
 
-  /** Configure Regular Channel
-  */
-  sConfig.Channel = ADC_CHANNEL_2;
-  sConfig.Rank = ADC_REGULAR_RANK_3;
-  if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
-  {
-    Error_Handler();
-  }
+  /* USER CODE END ADC1_Init 2 */
 
-  /** Configure Regular Channel
-  */
-  sConfig.Channel = ADC_CHANNEL_3;
-  sConfig.Rank = ADC_REGULAR_RANK_4;
-  if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
-  {
-    Error_Handler();
-  }
+}
 
-  /** Configure Regular Channel
+/**
+  * @brief ADC2 Initialization Function
+  * @param None
+  * @retval None
   */
-  sConfig.Channel = ADC_CHANNEL_4;
-  sConfig.Rank = ADC_REGULAR_RANK_5;
-  if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
-  {
-    Error_Handler();
-  }
+static void MX_ADC2_Init(void)
+{
 
-  /** Configure Regular Channel
-  */
-  sConfig.Channel = ADC_CHANNEL_5;
-  sConfig.Rank = ADC_REGULAR_RANK_6;
-  if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
-  {
-    Error_Handler();
-  }
+  /* USER CODE BEGIN ADC2_Init 0 */
+  /* ADC2 is only used as the slave of the optional dual
+     regular-simultaneous V/I mode (see acs712.c) */
+  /* USER CODE END ADC2_Init 0 */
 
-  /** Configure Regular Channel
+  ADC_ChannelConfTypeDef sConfig = {0};
+
+  /* USER CODE BEGIN ADC2_Init 1 */
+
+  /* USER CODE END ADC2_Init 1 */
+
+  /** Common config
   */
-  sConfig.Channel = ADC_CHANNEL_7;
-  sConfig.Rank = ADC_REGULAR_RANK_7;
-  if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+  hadc2.Instance = ADC2;
+  hadc2.Init.ScanConvMode = ADC_SCAN_DISABLE;
+  hadc2.Init.ContinuousConvMode = DISABLE;
+  hadc2.Init.DiscontinuousConvMode = DISABLE;
+  hadc2.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+  hadc2.Init.DataAlign = ADC_DATAALIGN_RIGHT;
+  hadc2.Init.NbrOfConversion = 1;
+  if (HAL_ADC_Init(&hadc2) != HAL_OK)
   {
     Error_Handler();
   }
 
   /** Configure Regular Channel
   */
-  sConfig.Channel = ADC_CHANNEL_6;
-  sConfig.Rank = ADC_REGULAR_RANK_8;
-  if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK)
+  sConfig.Channel = ADC_CHANNEL_7;
+  sConfig.Rank = ADC_REGULAR_RANK_1;
+  sConfig.SamplingTime = ADC_SAMPLETIME_71CYCLES_5;
+  if (HAL_ADC_ConfigChannel(&hadc2, &sConfig) != HAL_OK)
   {
     Error_Handler();
   }
-  /* USER CODE BEGIN ADC1_Init 2 */
+  /* USER CODE BEGIN ADC2_Init 2 */
 
-  /* USER CODE END ADC1_Init 2 */
+  /* USER CODE END ADC2_Init 2 */
 
 }
 
@@ -535,7 +612,7 @@ static void MX_TIM3_Init(void)
   htim3.Instance = TIM3;
   htim3.Init.Prescaler = 0;
   htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
-  htim3.Init.Period = 0xffff;
+  htim3.Init.Period = 20000-1;
   htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
   if (HAL_TIM_Base_Init(&htim3) != HAL_OK)
@@ -547,7 +624,7 @@ static void MX_TIM3_Init(void)
   {
     Error_Handler();
   }
-  sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+  sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
   sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
   if (HAL_TIMEx_MasterConfigSynchronization(&htim3, &sMasterConfig) != HAL_OK)
   {
@@ -592,6 +669,25 @@ static void MX_USART1_UART_Init(void)
 
 }
 
+/**
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void)
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA1_Channel1_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 1, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+  /* DMA1_Channel4_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 3, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
@@ -0,0 +1,160 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  METER – active/apparent power, PF and Wh counters
+ *
+ *  Energy is integrated as P held over the elapsed SysTick time
+ *  (mJ remainder, whole Wh carried into the counters), so a
+ *  missed mains cycle never loses energy.
+ ***************************************************************/
+
+#include "meter.h"
+#include "acs712.h"
+#include "eeprom_i2c.h"
+#include "rtc_i2c.h"
+#include "model_handle.h"
+#include "stm32f1xx_hal.h"
+#include <string.h>
+
+#define MJ_PER_WH   3600000UL
+
+/* One EEPROM ring slot (8 bytes, page aligned) */
+typedef struct {
+    uint32_t wh;
+    uint16_t seq;
+    uint16_t check;
+} MeterSlot;
+
+static MeterReadings m;
+
+static uint32_t residual_mJ  = 0;
+static uint32_t lastTick     = 0;
+static bool     lastMotorOn  = false;
+static uint8_t  lastDom      = 0;
+
+static uint32_t savedWh      = 0;
+static uint16_t slotSeq      = 0;
+static uint8_t  slotNext     = 0;
+
+static uint16_t slot_check(uint32_t wh, uint16_t seq)
+{
+    return (uint16_t)(wh ^ (wh >> 16) ^ seq ^ 0xA55A);
+}
+
+/***************************************************************
+ *  LIFETIME PERSISTENCE (wear-levelled ring)
+ ***************************************************************/
+static void ring_load(void)
+{
+    bool found = false;
+
+    for (uint8_t i = 0; i < METER_RING_SLOTS; i++)
+    {
+        MeterSlot s;
+        EEPROM_ReadBuffer(EE_ADDR_METER_RING + i * sizeof(MeterSlot),
+                          (uint8_t*)&s, sizeof(s));
+
+        if (s.check != slot_check(s.wh, s.seq))
+            continue;
+
+        /* newest = highest sequence (wrap-safe) */
+        if (!found || (int16_t)(s.seq - slotSeq) > 0)
+        {
+            found    = true;
+            slotSeq  = s.seq;
+            m.lifeWh = s.wh;
+            slotNext = (uint8_t)((i + 1) % METER_RING_SLOTS);
+        }
+    }
+
+    if (!found)
+    {
+        m.lifeWh = 0;
+        slotSeq  = 0;
+        slotNext = 0;
+    }
+    savedWh = m.lifeWh;
+}
+
+static void ring_save(void)
+{
+    MeterSlot s;
+    s.wh    = m.lifeWh;
+    s.seq   = (uint16_t)(slotSeq + 1);
+    s.check = slot_check(s.wh, s.seq);
+
+    if (EEPROM_WriteBuffer(EE_ADDR_METER_RING + slotNext * sizeof(MeterSlot),
+                           (uint8_t*)&s, sizeof(s)) != HAL_OK)
+        return;                                 // retry on next step
+
+    slotSeq  = s.seq;
+    slotNext = (uint8_t)((slotNext + 1) % METER_RING_SLOTS);
+    savedWh  = m.lifeWh;
+}
+
+void Meter_Flush(void)
+{
+    if (m.lifeWh != savedWh)
+        ring_save();
+}
+
+/***************************************************************
+ *  INIT / TASK
+ ***************************************************************/
+void Meter_Init(void)
+{
+    memset(&m, 0, sizeof(m));
+    ring_load();
+
+    lastTick    = HAL_GetTick();
+    lastMotorOn = Motor_GetStatus();
+    lastDom     = time.dom;
+}
+
+void Meter_Task(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t dt  = now - lastTick;
+    lastTick = now;
+
+    /* ---- instantaneous values ---- */
+    float P = g_powerW;
+    if (P < METER_MIN_W) P = 0.0f;
+
+    m.activeW    = P;
+    m.apparentVA = g_voltageV * g_currentA;
+    m.pf         = (m.apparentVA > METER_MIN_W) ? (P / m.apparentVA) : 0.0f;
+    if (m.pf > 1.0f) m.pf = 1.0f;
+
+    /* ---- run / day boundaries ---- */
+    bool motorOn = Motor_GetStatus();
+    if (motorOn && !lastMotorOn)
+        m.runWh = 0;                            // new run
+    if (!motorOn && lastMotorOn)
+        Meter_Flush();                          // run ended
+    lastMotorOn = motorOn;
+
+    if (time.dom != 0 && time.dom != lastDom)
+    {
+        m.dayWh = 0;
+        lastDom = time.dom;
+    }
+
+    /* ---- integrate (W * ms = mJ) ---- */
+    residual_mJ += (uint32_t)(P * (float)dt);
+
+    while (residual_mJ >= MJ_PER_WH)
+    {
+        residual_mJ -= MJ_PER_WH;
+        m.runWh++;
+        m.dayWh++;
+        m.lifeWh++;
+    }
+
+    if (m.lifeWh - savedWh >= METER_SAVE_STEP_WH)
+        ring_save();
+}
+
+const MeterReadings* Meter_Get(void)
+{
+    return &m;
+}
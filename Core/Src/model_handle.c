@@ -18,6 +18,11 @@
 #include "uart_commands.h"
 #include "stm32f1xx_hal.h"
 #include "eeprom_i2c.h"
+#include "fasttrip.h"
+#include "faultcap.h"
+#include "drypower.h"
+#include "startprof.h"
+#include "level.h"
 #include "main.h"          // <<< BUZZER ADDED: LED5_Pin / LED5_GPIO_Port
 #include <stdint.h>
 #include <stdbool.h>
@@ -57,6 +62,7 @@ volatile bool senseOverLoad       = false;
 volatile bool senseOverUnderVolt  = false;
 volatile bool senseMaxRunReached  = false;
 volatile bool senseUnderLoad      = false;
+volatile bool senseLevelFault     = false;
 volatile bool manualOverride      = false;
 
 /* Legacy externs from header */
@@ -78,6 +84,7 @@ static inline void stop_motor(void);
 static inline uint32_t now_ms(void);
 
 static void     protections_tick(void);
+static void     level_fault_check(void);
 static void     leds_from_model(void);
 static void     auto_tick(void);
 static void     twist_time_logic(void);
@@ -112,6 +119,11 @@ typedef struct {
 
 ModeState modeState;
 
+/* Last image actually written at 0x0200 – protections run every few ms,
+ * so unchanged snapshots must not cost an EEPROM page write. */
+static ModeState modeStateSaved;
+static bool      modeStateSavedValid = false;
+
 /* Power Restore runtime copy
  * 0 = YES  (restore last state; default)
  * 1 = NO   (start with everything OFF)
@@ -189,12 +201,20 @@ void ModelHandle_SaveModeState(void)
     modeState.motor_on           = (motorStatus == 1);
     modeState.power_restore_mode = powerRestoreMode;
 
+    if (modeStateSavedValid &&
+        memcmp(&modeStateSaved, &modeState, sizeof(modeState)) == 0)
+        return;
+
     EEPROM_WriteBuffer(0x0200, (uint8_t*)&modeState, sizeof(modeState));
+    modeStateSaved      = modeState;
+    modeStateSavedValid = true;
 }
 
 void ModelHandle_LoadModeState(void)
 {
     EEPROM_ReadBuffer(0x0200, (uint8_t*)&modeState, sizeof(modeState));
+    modeStateSaved      = modeState;
+    modeStateSavedValid = true;
 
     powerRestoreMode = modeState.power_restore_mode;
     if (powerRestoreMode > 2) powerRestoreMode = 0;
@@ -341,6 +361,8 @@ static inline void motor_apply(bool on)
 
     Relay_Set(1, on);
     motorStatus = on ? 1 : 0;
+    if (on)
+        StartProf_OnStart();
     UART_SendStatusPacket();
 }
 
@@ -502,27 +524,18 @@ void ModelHandle_ManualLongPress(void)
 }
 
 /***************************************************************
- *  TANK FULL DETECTION (Water level sensors)
+ *  TANK FULL DETECTION (level source: probes or ladder)
  ***************************************************************/
 static inline bool isTankFull(void)
 {
     static uint32_t stableStart = 0;
     static bool     lastState   = false;
 
-    bool allZero = true;
-
-    for (int i = 1; i <= 5; i++)
-    {
-        if (adcData.voltages[i] > 0.10f)
-        {
-            allZero = false;
-            break;
-        }
-    }
+    bool full = Level_IsFull();
 
     uint32_t now = HAL_GetTick();
 
-    if (allZero)
+    if (full)
     {
         if (!lastState)
         {
@@ -541,6 +554,21 @@ static inline bool isTankFull(void)
     return false;
 }
 
+/***************************************************************
+ *  LEVEL SENSOR FAULT
+ *  isTankFull() already reads a dead transducer as full, so the
+ *  automatic modes stop; this only makes the fault visible.
+ ***************************************************************/
+static void level_fault_check(void)
+{
+    bool fault = Level_IsFault();
+
+    if (fault && !senseLevelFault)
+        Buzzer_TriggerAlert();
+
+    senseLevelFault = fault;
+}
+
 /***************************************************************
  * RESET PUMP (SW1 single press – Restart the pump)
  ***************************************************************/
@@ -658,6 +686,11 @@ static uint32_t       loadTimer = 0;
 static uint8_t        loadRetryCount = 0;
 #define LOAD_MAX_RETRY           1   /* Spec: 1 retry only */
 
+/* AWD fast-trip (relay already off): the current reads 0 from now on,
+ * so the overload is held for one lock period instead of measured. */
+static uint32_t fastTripMs   = 0;
+static bool     fastTripHold = false;
+
 /* Compute lock duration using Testing Gap (sys.retry_count in minutes)
  * If Testing Gap is 0, fall back to default 20 minutes.
  */
@@ -685,8 +718,17 @@ void ModelHandle_CheckLoadFault(void)
     bool underloadEnabled = (ul > 0.1f);
     bool voltEnabled      = (uv > 0 || ov > 0);
 
-    bool overload  = overloadEnabled  && (I > ol);
-    bool underload = underloadEnabled && (I < ul);
+    bool fastTrip = FastTrip_TakeTrip();
+    if (fastTrip)
+    {
+        fastTripHold = true;
+        fastTripMs   = now;
+    }
+    if (fastTripHold && (now - fastTripMs) >= get_load_lock_duration_ms())
+        fastTripHold = false;
+
+    bool overload  = (overloadEnabled && (I > ol)) || fastTripHold;
+    bool underload = underloadEnabled && (I < ul) && !fastTripHold;
     bool voltFault = false;
 
     if (voltEnabled)
@@ -709,12 +751,31 @@ void ModelHandle_CheckLoadFault(void)
     bool fault = loadFault || voltFault;
     uint32_t lockDurationMs = get_load_lock_duration_ms();
 
+    uint8_t capCause = (overload     ? FAULTCAP_CAUSE_OVERLOAD  : 0)
+                     | (underload    ? FAULTCAP_CAUSE_UNDERLOAD : 0)
+                     | (voltFault    ? FAULTCAP_CAUSE_VOLT      : 0)
+                     | (fastTripHold ? FAULTCAP_CAUSE_FASTTRIP  : 0);
+
+    /* fast-trip skips the confirm window: straight to lock */
+    if (fastTrip)
+    {
+        stop_motor();               // relay is off already, sync motorStatus
+        FaultCap_Trigger(FAULTCAP_STAGE_LOCK, capCause);
+        loadState          = LOAD_FAULT_LOCK;
+        loadTimer          = now;
+        faultLocked        = true;
+        faultLockTimestamp = now;
+        Buzzer_TriggerAlert();
+        return;
+    }
+
     switch (loadState)
     {
         case LOAD_NORMAL:
             loadRetryCount = 0;
             if (fault && Motor_GetStatus())
             {
+                FaultCap_Trigger(FAULTCAP_STAGE_WAIT, capCause);
                 loadState = LOAD_FAULT_WAIT;
                 loadTimer = now;
             }
@@ -729,6 +790,7 @@ void ModelHandle_CheckLoadFault(void)
             if (now - loadTimer >= LOAD_FAULT_CONFIRM_MS)
             {
                 stop_motor();
+                FaultCap_Trigger(FAULTCAP_STAGE_LOCK, capCause);
                 loadState           = LOAD_FAULT_LOCK;
                 loadTimer           = now;
                 faultLocked         = true;
@@ -778,6 +840,7 @@ void ModelHandle_CheckLoadFault(void)
                 if (fault)
                 {
                     stop_motor();
+                    FaultCap_Trigger(FAULTCAP_STAGE_LOCK, capCause);
                     loadState   = LOAD_FAULT_LOCK;
                     loadTimer   = now;
                     faultLocked = true;
@@ -806,8 +869,14 @@ void ModelHandle_StopAllModesAndMotor(void)
 
 /***************************************************************
  *  DRY-RUN SENSOR CHECK
- *  Voltage <= 0.01f → WATER PRESENT → senseDryRun = false
- *  Voltage >  0.01f → DRY          → senseDryRun = true
+ *  Probe (ADC_CHANNEL_0):
+ *    Voltage <= 0.01f → WATER PRESENT
+ *    Voltage >  0.01f → DRY
+ *  Power signature (drypower.c), independent of the probe:
+ *    WET / DRY verdict overrides the probe, UNKNOWN (motor off,
+ *    start blanking, no baseline yet) leaves the probe in charge.
+ *    A stuck-dry probe no longer locks the pump out (the DRY_PROBE
+ *    run proves water), a stuck-wet probe no longer runs it dry.
  ***************************************************************/
 void ModelHandle_CheckDryRun(void)
 {
@@ -819,11 +888,16 @@ void ModelHandle_CheckDryRun(void)
     }
 
     float v = adcData.voltages[0];
+    bool probeDry = (v > 0.01f);
 
-    if (v > 0.01f)
-        senseDryRun = true;   /* DRY */
-    else
-        senseDryRun = false;  /* WATER OK */
+    DryPower_SetProbeWet(!probeDry);
+
+    switch (DryPower_GetVerdict())
+    {
+        case DRYPOWER_DRY: senseDryRun = true;     break;   /* DRY */
+        case DRYPOWER_WET: senseDryRun = false;    break;   /* WATER OK */
+        default:           senseDryRun = probeDry; break;
+    }
 }
 
 /***************************************************************
@@ -1502,6 +1576,7 @@ static void protections_tick(void)
  * - Red blink   : Max Run error
  * - Blue blink  : overload/underload
  * - Purple blink: over / under voltage
+ * - Red fast blink: level transducer fault
  */
 static void leds_from_model(void)
 {
@@ -1548,6 +1623,12 @@ static void leds_from_model(void)
         LED_SetIntent(LED_COLOR_PURPLE, LED_MODE_BLINK, 350);
     }
 
+    /* Level transducer fault → Red fast blink */
+    if (senseLevelFault)
+    {
+        LED_SetIntent(LED_COLOR_RED, LED_MODE_BLINK, 150);
+    }
+
     LED_ApplyIntents();
 }
 
@@ -1561,6 +1642,7 @@ void ModelHandle_Process(void)
     protections_tick();               /* Max Run latch enforcement     */
     twist_time_logic();               /* Time-based twist control      */
     check_max_run();                  /* Global Max Run                */
+    level_fault_check();              /* Transducer open / broken wire */
 
     if (senseMaxRunReached)
     {
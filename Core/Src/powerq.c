@@ -0,0 +1,360 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  POWER QUALITY – frequency, sag/swell/interruption event log
+ *
+ *  Thresholds follow the IEC 61000-4-30 idea on a per-cycle
+ *  (not half-cycle) RMS: start/end with hysteresis, duration in
+ *  cycles, depth as the extreme reached. Detection is float on
+ *  50 values a second; the log is integer and 16 B per event.
+ ***************************************************************/
+
+#include "powerq.h"
+#include "eeprom_i2c.h"
+#include "rtc_i2c.h"
+#include "uart.h"
+#include "stm32f1xx_hal.h"
+#include <stdio.h>
+#include <string.h>
+
+#define V_SAG      (PQ_NOMINAL_V * PQ_SAG_PCT / 100.0f)
+#define V_SWELL    (PQ_NOMINAL_V * PQ_SWELL_PCT / 100.0f)
+#define V_INT      (PQ_NOMINAL_V * PQ_INTERRUPT_PCT / 100.0f)
+#define V_HYST     (PQ_NOMINAL_V * PQ_HYST_PCT / 100.0f)
+
+#define PENDING_MAX   4
+#define CLEAR_RETRIES 5                 // per slot, one try per pass
+
+_Static_assert(sizeof(PqRecord) == 16, "PqRecord is one 16-byte ring slot");
+
+typedef enum { V_NORMAL = 0, V_IN_SAG, V_IN_SWELL } VState;
+
+static PqStats st;
+
+/* voltage event in progress */
+static VState   s_vState = V_NORMAL;
+static uint32_t s_vStamp;
+static uint32_t s_vCycles;
+static float    s_vExt;
+
+/* frequency excursion in progress */
+static uint32_t s_fStamp;
+static uint32_t s_fCycles;
+static float    s_fExt;
+
+static uint32_t s_lastSeq;
+static bool     s_haveSeq = false;
+static float    s_hzSum;
+static uint8_t  s_hzN;
+
+/* ring */
+static uint16_t s_seq     = 0;
+static uint8_t  s_next    = 0;
+static uint8_t  s_used    = 0;
+static PqRecord s_pending[PENDING_MAX];
+static uint8_t  s_pendN   = 0;
+
+/* dump cursor */
+static bool     s_dumping = false;
+static uint8_t  s_dumpK;
+
+/* clear cursor: one slot per pass, like the appends */
+static bool     s_clearing = false;
+static uint8_t  s_clearK;
+static uint8_t  s_clearTries;
+
+static uint16_t record_check(const PqRecord *r)
+{
+    return (uint16_t)(r->stamp ^ (r->stamp >> 16) ^ r->cycles ^
+                      (r->extreme << 1) ^ r->type ^ r->seq ^ 0x5AC3);
+}
+
+static uint32_t stamp_now(void)
+{
+    uint32_t yy = (time.year >= 2000) ? (uint32_t)(time.year - 2000U) : 0U;
+
+    return ((yy & 0x3F) << 26) | ((uint32_t)time.month << 22) |
+           ((uint32_t)time.dom << 17) | ((uint32_t)time.hour << 12) |
+           ((uint32_t)time.min << 6) | time.sec;
+}
+
+static void queue_event(PqEventType type, uint32_t stamp, uint32_t cycles, uint16_t ext)
+{
+    if (type <= PQ_EVT_POWERUP && st.count[type] < 0xFFFF)
+        st.count[type]++;
+
+    if (s_pendN >= PENDING_MAX)
+        return;                                 // burst: counters still see it
+
+    PqRecord *r = &s_pending[s_pendN++];
+    memset(r, 0, sizeof(*r));
+    r->stamp   = stamp;
+    r->cycles  = (uint16_t)((cycles > 0xFFFF) ? 0xFFFF : cycles);
+    r->extreme = ext;
+    r->type    = (uint8_t)type;
+}
+
+static uint16_t v_x10(float v)
+{
+    return (uint16_t)((v < 0.0f) ? 0 : (v * 10.0f + 0.5f));
+}
+
+/***************************************************************
+ *  RING (same scheme as the meter: newest = highest seq)
+ ***************************************************************/
+void PowerQ_Init(void)
+{
+    bool found = false;
+
+    memset(&st, 0, sizeof(st));
+    st.vMin  = st.hzMin = 1.0e6f;
+
+    for (uint8_t i = 0; i < PQ_RING_SLOTS; i++)
+    {
+        PqRecord r;
+        if (EEPROM_ReadBuffer(EE_ADDR_PQ_RING + i * sizeof(PqRecord),
+                              (uint8_t*)&r, sizeof(r)) != HAL_OK)
+            continue;
+        if (r.type == 0 || r.check != record_check(&r))
+            continue;
+
+        s_used++;
+        if (!found || (int16_t)(r.seq - s_seq) > 0)
+        {
+            found  = true;
+            s_seq  = r.seq;
+            s_next = (uint8_t)((i + 1) % PQ_RING_SLOTS);
+        }
+    }
+
+    queue_event(PQ_EVT_POWERUP, stamp_now(), 0, 0);
+}
+
+static bool ring_append(PqRecord *r)
+{
+    r->seq   = (uint16_t)(s_seq + 1);
+    r->check = record_check(r);
+
+    if (EEPROM_WriteBuffer(EE_ADDR_PQ_RING + s_next * sizeof(PqRecord),
+                           (uint8_t*)r, sizeof(*r)) != HAL_OK)
+        return false;
+
+    s_seq  = r->seq;
+    s_next = (uint8_t)((s_next + 1) % PQ_RING_SLOTS);
+    if (s_used < PQ_RING_SLOTS)
+        s_used++;
+    return true;
+}
+
+/***************************************************************
+ *  PER-CYCLE DETECTION
+ ***************************************************************/
+void PowerQ_OnCycle(float vRms, float hz, uint32_t seq)
+{
+    /* cycles the task skipped still belong to a running event */
+    uint32_t n = 1;
+    if (s_haveSeq && seq - s_lastSeq > 1U)
+    {
+        n        = seq - s_lastSeq;
+        st.lost += n - 1U;
+    }
+    s_lastSeq = seq;
+    s_haveSeq = true;
+    st.cycles += n;
+
+    if (vRms < st.vMin) st.vMin = vRms;
+    if (vRms > st.vMax) st.vMax = vRms;
+
+    /* ---- voltage ---- */
+    switch (s_vState)
+    {
+        case V_NORMAL:
+            if (vRms < V_SAG || vRms > V_SWELL)
+            {
+                s_vState  = (vRms < V_SAG) ? V_IN_SAG : V_IN_SWELL;
+                s_vStamp  = stamp_now();
+                s_vCycles = 1;
+                s_vExt    = vRms;
+            }
+            break;
+
+        case V_IN_SAG:
+            s_vCycles += n;
+            if (vRms < s_vExt) s_vExt = vRms;
+            if (vRms >= V_SAG + V_HYST)
+            {
+                queue_event((s_vExt < V_INT) ? PQ_EVT_INTERRUPTION : PQ_EVT_SAG,
+                            s_vStamp, s_vCycles - 1U, v_x10(s_vExt));
+                s_vState = V_NORMAL;
+            }
+            break;
+
+        case V_IN_SWELL:
+            s_vCycles += n;
+            if (vRms > s_vExt) s_vExt = vRms;
+            if (vRms <= V_SWELL - V_HYST)
+            {
+                queue_event(PQ_EVT_SWELL, s_vStamp, s_vCycles - 1U, v_x10(s_vExt));
+                s_vState = V_NORMAL;
+            }
+            break;
+    }
+
+    /* ---- frequency (only while synchronised) ---- */
+    if (hz <= 0.0f)
+        return;
+
+    if (hz < st.hzMin) st.hzMin = hz;
+    if (hz > st.hzMax) st.hzMax = hz;
+
+    s_hzSum += hz;
+    if (++s_hzN >= (uint8_t)PQ_NOMINAL_HZ)
+    {
+        st.hzAvg = s_hzSum / (float)s_hzN;
+        s_hzSum  = 0.0f;
+        s_hzN    = 0;
+    }
+
+    float dev = hz - PQ_NOMINAL_HZ;
+    bool  off = (dev > PQ_FREQ_DEV_HZ) || (dev < -PQ_FREQ_DEV_HZ);
+
+    if (off)
+    {
+        if (s_fCycles == 0)
+        {
+            s_fStamp = stamp_now();
+            s_fExt   = hz;
+        }
+        s_fCycles += n;
+
+        float e = s_fExt - PQ_NOMINAL_HZ;
+        if ((dev > 0 ? dev : -dev) > (e > 0 ? e : -e))
+            s_fExt = hz;
+    }
+    else if (s_fCycles)
+    {
+        if (s_fCycles >= PQ_FREQ_MIN_CYCLES)
+            queue_event(PQ_EVT_FREQ, s_fStamp, s_fCycles,
+                        (uint16_t)(s_fExt * 100.0f + 0.5f));
+        s_fCycles = 0;
+    }
+}
+
+/***************************************************************
+ *  UART TASK: flush one pending record, then one dump line
+ ***************************************************************/
+static const char *type_name(uint8_t t)
+{
+    switch (t)
+    {
+        case PQ_EVT_SAG:          return "SAG";
+        case PQ_EVT_SWELL:        return "SWELL";
+        case PQ_EVT_INTERRUPTION: return "INT";
+        case PQ_EVT_FREQ:         return "FREQ";
+        case PQ_EVT_POWERUP:      return "BOOT";
+        default:                  return "?";
+    }
+}
+
+/* The RAM view only forgets the log once every slot is zeroed;
+   a slot that keeps failing aborts the clear and leaves it as is */
+static void clear_step(void)
+{
+    PqRecord z;
+
+    memset(&z, 0, sizeof(z));
+    if (EEPROM_WriteBuffer(EE_ADDR_PQ_RING + s_clearK * sizeof(PqRecord),
+                           (uint8_t*)&z, sizeof(z)) != HAL_OK)
+    {
+        if (++s_clearTries >= CLEAR_RETRIES)
+        {
+            UART_TransmitPacket("PQ:CLEAR:FAIL");
+            s_clearing = false;
+        }
+        return;
+    }
+
+    s_clearTries = 0;
+    if (++s_clearK < PQ_RING_SLOTS)
+        return;
+
+    s_used     = 0;
+    s_next     = 0;
+    s_clearing = false;
+
+    memset(&st, 0, sizeof(st));
+    st.vMin = st.hzMin = 1.0e6f;
+
+    UART_TransmitPacket("PQ:CLEARED");
+}
+
+void PowerQ_Task(void)
+{
+    if (s_clearing)
+    {
+        clear_step();
+        return;
+    }
+
+    if (s_pendN && ring_append(&s_pending[0]))
+    {
+        s_pendN--;
+        memmove(&s_pending[0], &s_pending[1], s_pendN * sizeof(PqRecord));
+        return;
+    }
+
+    if (!s_dumping)
+        return;
+
+    if (s_dumpK >= s_used)
+    {
+        UART_TransmitPacket("PQE:END");
+        s_dumping = false;
+        return;
+    }
+
+    /* newest first */
+    uint8_t  slot = (uint8_t)((s_next + 2U * PQ_RING_SLOTS - 1U - s_dumpK) % PQ_RING_SLOTS);
+    PqRecord r;
+    char     line[56];
+
+    s_dumpK++;
+    if (EEPROM_ReadBuffer(EE_ADDR_PQ_RING + slot * sizeof(PqRecord),
+                          (uint8_t*)&r, sizeof(r)) != HAL_OK ||
+        r.type == 0 || r.check != record_check(&r))
+        return;
+
+    snprintf(line, sizeof(line), "PQE:%u:%s:%02lu-%02lu-%02lu %02lu:%02lu:%02lu:%lu:%u",
+             s_dumpK - 1U, type_name(r.type),
+             (unsigned long)PQ_STAMP_YY(r.stamp), (unsigned long)PQ_STAMP_MM(r.stamp),
+             (unsigned long)PQ_STAMP_DD(r.stamp), (unsigned long)PQ_STAMP_HH(r.stamp),
+             (unsigned long)PQ_STAMP_MI(r.stamp), (unsigned long)PQ_STAMP_SS(r.stamp),
+             (unsigned long)r.cycles * 20UL, r.extreme);
+    UART_TransmitPacket(line);
+}
+
+bool PowerQ_StartDump(void)
+{
+    if (s_used == 0 || s_dumping || s_clearing)
+        return false;
+
+    s_dumpK   = 0;
+    s_dumping = true;
+    return true;
+}
+
+/* Starts the erase; PowerQ_Task writes one slot per pass (the
+   EEPROM NACKs for its ~5 ms write cycle, the UART task runs every
+   10 ms) and reports "PQ:CLEARED" or "PQ:CLEAR:FAIL" */
+void PowerQ_Clear(void)
+{
+    s_pendN      = 0;
+    s_dumping    = false;
+    s_clearK     = 0;
+    s_clearTries = 0;
+    s_clearing   = true;
+}
+
+const PqStats* PowerQ_GetStats(void)
+{
+    return &st;
+}
@@ -0,0 +1,190 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  PRESSURE LEVEL – continuous tank level from a transducer
+ *
+ *  PLevel_Feed is the whole signal path and takes plain counts,
+ *  so any sample source can drive it; PLevel_Update only pulls
+ *  the median-filtered value of the configured input.
+ ***************************************************************/
+
+#include "pressure_level.h"
+#include "adc.h"
+#include "eeprom_i2c.h"
+
+#define PLEV_SIGNATURE   0x91E5
+
+
+static PlevConfig s_cfg = {
+    .probe      = PLEV_DEFAULT_PROBE,
+    .shape      = PLEV_TANK_VERTICAL,
+    .zeroCounts = PLEV_MA420_ZERO,
+    .spanCounts = PLEV_MA420_SPAN,
+    .fsMm       = PLEV_DEFAULT_FS_MM,
+    .sensorMm   = 0,
+    .fullMm     = 1000
+};
+
+static int32_t  s_ema = -1;             // Q4 counts, -1 = unseeded
+static uint16_t s_raw;
+static bool     s_valid = false;
+static uint16_t s_mm;
+static bool     s_full = false;
+static uint16_t s_faults;
+
+/* horizontal cylinder: volume ‰ at fill height 0, 10 .. 100 % of D */
+static const uint16_t hcylVol[11] = {
+    0, 52, 142, 252, 374, 500, 626, 748, 858, 948, 1000
+};
+
+static void save(void)
+{
+    EEPROM_WriteRecord(EE_ADDR_PLEVEL, &s_cfg, sizeof(s_cfg), PLEV_SIGNATURE);
+}
+
+void PLevel_Init(void)
+{
+    PlevConfig c;
+
+    if (!EEPROM_ReadRecord(EE_ADDR_PLEVEL, &c, sizeof(c), PLEV_SIGNATURE))
+        return;
+    if (c.probe < 1 || c.probe >= ADC_CHANNEL_COUNT ||
+        c.spanCounts == 0 || c.fullMm == 0)
+        return;
+
+    s_cfg = c;
+}
+
+void PLevel_Feed(uint16_t counts)
+{
+    s_raw = counts;
+
+    if (s_ema < 0)
+        s_ema = (int32_t)counts << 4;
+    else
+        s_ema += (((int32_t)counts << 4) - s_ema) >> PLEV_EMA_SHIFT;
+
+    int32_t c = (s_ema + 8) >> 4;
+    bool    wasValid = s_valid;
+
+    s_valid = (c + PLEV_FAULT_COUNTS >= (int32_t)s_cfg.zeroCounts);
+    if (!s_valid)
+    {
+        if (wasValid && s_faults < 0xFFFF)
+            s_faults++;
+        s_full = false;
+        return;
+    }
+
+    int32_t head = (c - (int32_t)s_cfg.zeroCounts) * s_cfg.fsMm / s_cfg.spanCounts;
+    if (head < 0)
+        head = 0;
+
+    int32_t mm = head + s_cfg.sensorMm;
+    s_mm = (uint16_t)((mm > 0xFFFF) ? 0xFFFF : mm);
+
+    if (!s_full && s_mm >= s_cfg.fullMm)
+        s_full = true;
+    else if (s_full && s_mm + PLEV_FULL_HYST_MM < s_cfg.fullMm)
+        s_full = false;
+}
+
+void PLevel_Update(void)
+{
+    PLevel_Feed(ADC_GetFilteredCounts(s_cfg.probe));
+}
+
+bool PLevel_IsValid(void)
+{
+    return s_valid;
+}
+
+uint16_t PLevel_GetMm(void)
+{
+    return s_valid ? s_mm : 0;
+}
+
+uint8_t PLevel_GetPercent(void)
+{
+    if (!s_valid)
+        return 0;
+
+    uint32_t pm = (uint32_t)s_mm * 1000U / s_cfg.fullMm;     // ‰ of height
+    if (pm > 1000U)
+        pm = 1000U;
+
+    if (s_cfg.shape == PLEV_TANK_HORIZONTAL)
+    {
+        uint32_t i = pm / 100U, f = pm % 100U;
+        pm = (i >= 10U) ? 1000U
+           : hcylVol[i] + (hcylVol[i + 1] - hcylVol[i]) * f / 100U;
+    }
+    return (uint8_t)((pm + 5U) / 10U);
+}
+
+/* fail-safe: a dead transducer reads full, like an unplugged
+   probe harness (0 V = wet), so no automatic mode keeps pumping */
+bool PLevel_IsFull(void)
+{
+    return !s_valid || s_full;
+}
+
+uint16_t PLevel_GetFaultCount(void)
+{
+    return s_faults;
+}
+
+uint16_t PLevel_GetRaw(void)
+{
+    return s_raw;
+}
+
+const PlevConfig* PLevel_GetConfig(void)
+{
+    return &s_cfg;
+}
+
+void PLevel_ApplyPreset(PlevPreset p, uint16_t fsMm)
+{
+    if (p == PLEV_PRESET_V05)
+    {
+        s_cfg.zeroCounts = PLEV_V05_ZERO;
+        s_cfg.spanCounts = PLEV_V05_SPAN;
+    }
+    else
+    {
+        s_cfg.zeroCounts = PLEV_MA420_ZERO;
+        s_cfg.spanCounts = PLEV_MA420_SPAN;
+    }
+    if (fsMm)
+        s_cfg.fsMm = fsMm;
+    save();
+}
+
+void PLevel_CaptureZero(void)
+{
+    s_cfg.zeroCounts = ADC_GetFilteredCounts(s_cfg.probe);
+    save();
+}
+
+bool PLevel_SetTank(uint16_t fullMm, uint16_t sensorMm, PlevTankShape shape)
+{
+    if (fullMm == 0 || shape > PLEV_TANK_HORIZONTAL)
+        return false;
+
+    s_cfg.fullMm   = fullMm;
+    s_cfg.sensorMm = sensorMm;
+    s_cfg.shape    = (uint8_t)shape;
+    save();
+    return true;
+}
+
+bool PLevel_SetProbe(uint8_t probe)
+{
+    if (probe < 1 || probe >= ADC_CHANNEL_COUNT)
+        return false;
+
+    s_cfg.probe = probe;
+    s_ema       = -1;
+    save();
+    return true;
+}
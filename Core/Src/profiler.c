@@ -0,0 +1,85 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  PROFILER – DWT cycle counter timing of the main-loop stages
+ *
+ *  CYCCNT runs at SYSCLK (64 MHz) and wraps every ~67 s; the
+ *  unsigned end-start difference is valid for any stage shorter
+ *  than that.
+ ***************************************************************/
+
+#include "profiler.h"
+#include <string.h>
+
+static ProfStats s_prof[PROF_STAGE_COUNT];
+
+static const char * const s_names[PROF_STAGE_COUNT] = {
+    [PROF_ACS712_UPDATE]  = "ACS",
+    [PROF_ADC_READ]       = "ADC",
+    [PROF_SWITCHES]       = "SW",
+    [PROF_SCREEN_UPDATE]  = "LCD",
+    [PROF_RTC_READ]       = "RTC",
+    [PROF_MODEL_PROCESS]  = "MODEL",
+    [PROF_DRYRUN_PROCESS] = "DRY",
+    [PROF_LORA_TASK]      = "LORA",
+    [PROF_LED_TASK]       = "LED",
+    [PROF_ADC_BLOCK]      = "ADCBLK",
+    [PROF_PROBE_DECIM]    = "PRB",
+};
+
+void Prof_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Prof_Reset();
+}
+
+void Prof_Reset(void)
+{
+    memset(s_prof, 0, sizeof(s_prof));
+    for (uint8_t i = 0; i < PROF_STAGE_COUNT; i++)
+        s_prof[i].min_cyc = UINT32_MAX;
+}
+
+uint32_t Prof_CyclesToUs(uint32_t cycles)
+{
+    uint32_t per_us = SystemCoreClock / 1000000U;
+    return per_us ? (cycles / per_us) : cycles;
+}
+
+/* floor(log2(us)) clamped into the histogram */
+static uint8_t hist_bin(uint32_t us)
+{
+    if (us < 2U) return 0;
+
+    uint8_t bin = (uint8_t)(31U - __CLZ(us));
+    return (bin >= PROF_HIST_BINS) ? (PROF_HIST_BINS - 1) : bin;
+}
+
+void Prof_End(ProfStage stage, uint32_t start_cyc)
+{
+    if (stage >= PROF_STAGE_COUNT) return;
+
+    uint32_t cyc = DWT->CYCCNT - start_cyc;
+    ProfStats *p = &s_prof[stage];
+
+    p->count++;
+    p->sum_cyc += cyc;
+    if (cyc < p->min_cyc) p->min_cyc = cyc;
+    if (cyc > p->max_cyc) p->max_cyc = cyc;
+
+    uint8_t bin = hist_bin(Prof_CyclesToUs(cyc));
+    if (p->hist[bin] != UINT16_MAX)
+        p->hist[bin]++;
+}
+
+const ProfStats* Prof_GetStats(ProfStage stage)
+{
+    return (stage < PROF_STAGE_COUNT) ? &s_prof[stage] : NULL;
+}
+
+const char* Prof_StageName(ProfStage stage)
+{
+    return (stage < PROF_STAGE_COUNT) ? s_names[stage] : "?";
+}
@@ -1,12 +1,13 @@
 #include "rf.h"
 #include "stm32f1xx_hal.h"   // or stm32f0xx_hal.h depending on your MCU
 
-extern TIM_HandleTypeDef htim3;  // Timer3 must be initialized in main.c
-
-// --- private microsecond delay using TIM3 ---
+// --- private microsecond delay using the DWT cycle counter ---
+// (TIM3 is the ADC sample clock now and must not be reset here;
+//  CYCCNT is enabled at boot by Prof_Init())
 static void rf_delay_us(uint32_t us) {
-    __HAL_TIM_SET_COUNTER(&htim3, 0);
-    while (__HAL_TIM_GET_COUNTER(&htim3) < us);
+    uint32_t start  = DWT->CYCCNT;
+    uint32_t cycles = us * (SystemCoreClock / 1000000U);
+    while ((DWT->CYCCNT - start) < cycles);
 }
 
 // --- init RF pin (set low) ---
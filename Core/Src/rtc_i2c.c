@@ -1,5 +1,6 @@
 #include "rtc_i2c.h"
 #include "stm32f1xx_hal.h"
+#include "lcd_i2c.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -80,6 +81,7 @@ void RTC_SetTimeDate(uint8_t sec, uint8_t min, uint8_t hour,
     buf[6] = dec2bcd(year - 2000);          // DS1307 stores only last 2 digits
 
     /* DS1307 WRITE REQUIRES 10ms — NOT 5ms */
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);      // I2C2 shared with LCD DMA
     HAL_I2C_Mem_Write(&hi2c2, DS1307_8BIT_ADDR,
                       0x00, I2C_MEMADD_SIZE_8BIT,
                       buf, 7, 200);
@@ -95,6 +97,7 @@ void RTC_GetTimeDate(void)
     uint8_t buf[7];
 
     /* READ ALL 7 BYTES IN ONE SHOT */
+    lcd_async_wait_idle(LCD_ASYNC_TIMEOUT_MS);      // I2C2 shared with LCD DMA
     if (HAL_I2C_Mem_Read(&hi2c2, DS1307_8BIT_ADDR,
                          0x00, I2C_MEMADD_SIZE_8BIT,
                          buf, 7, 200) != HAL_OK)
@@ -0,0 +1,137 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  SCHEDULER – static task table, cooperative, deadline aware
+ *
+ *  Selection rule on every pass:
+ *    1) only tasks whose release time has passed are ready
+ *    2) lowest priority number wins
+ *    3) equal priority → earliest absolute deadline wins
+ *  Nothing ready → WFI until the next SysTick / peripheral IRQ.
+ ***************************************************************/
+
+#include "scheduler.h"
+#include "stm32f1xx_hal.h"
+#include <string.h>
+
+static const SchedTask *s_table = NULL;
+static uint8_t          s_count = 0;
+
+static uint32_t       s_release[SCHED_MAX_TASKS];   // next release (HAL tick)
+static SchedTaskStats s_stats[SCHED_MAX_TASKS];
+
+static inline uint16_t task_deadline(const SchedTask *t)
+{
+    return (t->deadline_ms != 0) ? t->deadline_ms : t->period_ms;
+}
+
+void Scheduler_Init(const SchedTask *table, uint8_t count)
+{
+    if (count > SCHED_MAX_TASKS)
+        count = SCHED_MAX_TASKS;
+
+    s_table = table;
+    s_count = count;
+
+    uint32_t now = HAL_GetTick();
+    for (uint8_t i = 0; i < s_count; i++)
+        s_release[i] = now;                 // everything due on first pass
+
+    Scheduler_ResetStats();
+}
+
+void Scheduler_ResetStats(void)
+{
+    memset(s_stats, 0, sizeof(s_stats));
+}
+
+/* Pick the ready task with best (priority, absolute deadline) */
+static int8_t pick_ready(uint32_t now)
+{
+    int8_t best = -1;
+
+    for (uint8_t i = 0; i < s_count; i++)
+    {
+        if ((int32_t)(now - s_release[i]) < 0)
+            continue;                       // not released yet
+
+        if (best < 0)
+        {
+            best = (int8_t)i;
+            continue;
+        }
+
+        const SchedTask *a = &s_table[i];
+        const SchedTask *b = &s_table[best];
+
+        if (a->priority < b->priority)
+        {
+            best = (int8_t)i;
+        }
+        else if (a->priority == b->priority)
+        {
+            uint32_t dl_a = s_release[i]    + task_deadline(a);
+            uint32_t dl_b = s_release[best] + task_deadline(b);
+            if ((int32_t)(dl_a - dl_b) < 0)
+                best = (int8_t)i;
+        }
+    }
+    return best;
+}
+
+void Scheduler_RunOnce(void)
+{
+    if (s_table == NULL || s_count == 0)
+        return;
+
+    int8_t idx = pick_ready(HAL_GetTick());
+
+    if (idx < 0)
+    {
+        /* Idle: sleep until SysTick (1 ms) or any other interrupt */
+        __WFI();
+        return;
+    }
+
+    const SchedTask *t  = &s_table[idx];
+    SchedTaskStats  *st = &s_stats[idx];
+    uint32_t release    = s_release[idx];
+
+    t->fn();
+
+    uint32_t done    = HAL_GetTick();
+    uint32_t latency = done - release;
+
+    st->runs++;
+    st->last_ms = (latency > 0xFFFF) ? 0xFFFF : (uint16_t)latency;
+    if (st->last_ms > st->worst_ms)
+        st->worst_ms = st->last_ms;
+
+    if (latency > task_deadline(t))
+        st->overruns++;
+
+    /* Keep the release grid; drop whole periods we already missed
+       (one catch-up run is still allowed immediately). */
+    uint32_t next = release + t->period_ms;
+    if ((int32_t)(done - next) >= (int32_t)t->period_ms)
+    {
+        uint32_t lost = (done - next) / t->period_ms;
+        st->skipped  += lost;
+        next         += lost * t->period_ms;
+    }
+    s_release[idx] = next;
+}
+
+uint8_t Scheduler_GetTaskCount(void)
+{
+    return s_count;
+}
+
+const SchedTask* Scheduler_GetTask(uint8_t idx)
+{
+    return (idx < s_count) ? &s_table[idx] : NULL;
+}
+
+const SchedTaskStats* Scheduler_GetStats(uint8_t idx)
+{
+    return (idx < s_count) ? &s_stats[idx] : NULL;
+}
@@ -6,10 +6,16 @@
 
 #include "screen.h"
 #include "lcd_i2c.h"
+#include "lcd_fb.h"
+#include "lcd_cgram.h"
 #include "switches.h"
 #include "model_handle.h"
 #include "adc.h"
 #include "rtc_i2c.h"
+#include "meter.h"
+#include "acs712.h"
+#include "level.h"
+#include "lora.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -84,6 +90,9 @@ typedef enum {
     /* Reset confirm from main menu */
     UI_RESET_CONFIRM,
 
+    /* Energy meter pages (UP/DOWN to flip) */
+    UI_METER,
+
     UI_NONE,
     UI_MAX_
 } UiState;
@@ -134,6 +143,10 @@ static uint32_t last_repeat_time = 0;
 /* For reset confirm screen */
 static bool reset_confirm_yes = false;
 
+/* Menu engine: field being edited, first visible list row */
+static uint8_t ui_field = 0;
+static uint8_t ui_top   = 0;
+
 /* ================================================================
    EXTERNAL STATES (from model_handle / rtc_i2c)
    ================================================================ */
@@ -159,8 +172,6 @@ static uint8_t edit_on_m = 0;
 static uint8_t edit_off_h = 0;
 static uint8_t edit_off_m = 0;
 
-static uint8_t time_edit_field = 0; // 0 = HH, 1 = MM
-
 /* Days mask & selection index */
 static uint8_t edit_day_mask = 0x7F; // default 7 days ON
 static uint8_t edit_day_index = 0;   // 0..9
@@ -174,9 +185,6 @@ static bool edit_slot_enabled = true;
 /* Which slot is being edited? 0..4, 5=Back */
 static uint8_t currentSlot = 0;
 
-/* Slot page: 0 → T1/T2, 1 → T3/T4, 2 → T5/BACK */
-static uint8_t timer_page = 0;
-
 /* ================================================================
    AUTO / TWIST / COUNTDOWN / SETTINGS TEMP VARS
    ================================================================ */
@@ -218,11 +226,9 @@ static bool     edit_settings_factory_yes = false;
 static uint8_t  edit_date_dd    = 1;
 static uint8_t  edit_date_mm    = 1;
 static uint16_t edit_date_yyyy  = 2025;
-static uint8_t  edit_date_field = 0;  // 0=DD,1=MM,2=YY
 
 static uint8_t  edit_time_hh    = 0;
 static uint8_t  edit_time_min   = 0;
-static uint8_t  edit_time_field = 0;  // 0=HH,1=MM
 
 /* Day index 0..6 -> Sun..Sat */
 static uint8_t  edit_day_idx2   = 0;
@@ -244,43 +250,11 @@ static const char* const addDevTypeNames[] = {
     "Transmitter"
 };
 
-/* ================================================================
-   MAIN MENU ITEMS (as per document)
-   ================================================================ */
-static const char* const main_menu[] = {
-    "Timer Setting",     // 0
-    "Add New Device",    // 1
-    "Device Setup",      // 2
-    "Reset To Default"   // 3
-};
-#define MAIN_MENU_COUNT 4
-
-static uint8_t menu_idx      = 0;
-static uint8_t menu_view_top = 0;
+#define METER_PAGE_COUNT 3
+static uint8_t meter_page = 0;
 
-/* ================================================================
-   DEVICE SETUP SCROLL MENU
-   (Mapped to individual edit screens)
-   ================================================================ */
-static const char* const devset_menu_items[] = {
-    "Set Dry Run",     // -> UI_SETTINGS_GAP
-    "Set Testing Gap", // -> UI_SETTINGS_RETRY
-    "Set Low Volt",    // -> UI_SETTINGS_UV
-    "Set High Volt",   // -> UI_SETTINGS_OV
-    "Set Over Load",   // -> UI_SETTINGS_OL
-    "Set Under Load",  // -> UI_SETTINGS_UL
-    "Set Max Run",     // -> UI_SETTINGS_MAXRUN
-    "Set Date",        // -> UI_DEVSET_EDIT_DATE
-    "Set Time",        // -> UI_DEVSET_EDIT_TIME
-    "Set Day",         // -> UI_DEVSET_EDIT_DAY
-    "Power Restore",   // -> UI_SETTINGS_PWRREST
-    "Factory Reset",   // -> UI_SETTINGS_FACTORY
-    "Back"             // -> Back to Main Menu
-};
-#define DEVSET_MENU_COUNT  (sizeof(devset_menu_items)/sizeof(devset_menu_items[0]))
-
-static uint8_t devset_idx      = 0;
-static uint8_t devset_view_top = 0;
+static uint8_t menu_idx   = 0;
+static uint8_t devset_idx = 0;
 
 /* ================================================================ */
 
@@ -288,6 +262,7 @@ void Screen_Init(void)
 {
     lcd_init();
     lcd_clear();
+    lcd_fb_init();               // glass is blank, shadow matches
 
     ui = UI_WELCOME;
     last_ui = UI_NONE;
@@ -303,11 +278,9 @@ static inline void refreshInactivityTimer(void){
     lastUserAction = HAL_GetTick();
 }
 
+/* Draws go to the shadow framebuffer; Screen_Update flushes the diff */
 static inline void lcd_line(uint8_t row, const char* s){
-    char buf[17];
-    snprintf(buf, sizeof(buf), "%-16.16s", s);
-    lcd_put_cur(row,0);
-    lcd_send_string(buf);
+    lcd_fb_line(row, s);
 }
 
 static inline void lcd_line0(const char* s){ lcd_line(0,s); }
@@ -322,7 +295,7 @@ static inline void lcd_line1(const char* s){ lcd_line(1,s); }
  ***************************************************************/
 static void show_welcome(void)
 {
-    lcd_clear();
+    lcd_fb_clear();
     lcd_line0("   HELONIX");
     lcd_line1(" IntelligentSys");
 }
@@ -330,9 +303,23 @@ static void show_welcome(void)
 /***************************************************************
  *  DASHBOARD SCREEN
  ***************************************************************/
+/* width cells of bar graph for pct: ROM full blocks + one CGRAM partial */
+static void dash_bar(char *out, uint8_t width, uint8_t pct)
+{
+    uint16_t units = (uint16_t)((uint32_t)pct * width * 5U / 100U);
+
+    for (uint8_t i = 0; i < width; i++, units = (units > 5) ? units - 5 : 0)
+    {
+        if (units >= 5)      out[i] = LCD_GLYPH_BLOCK;
+        else if (units > 0)  out[i] = lcd_cgram_get((LcdGlyph)(GLYPH_BAR_1 + units - 1));
+        else                 out[i] = ' ';
+    }
+    out[width] = '\0';
+}
+
 static void show_dash(void)
 {
-    char l0[17], l1[17];
+    char l0[17], l1[17], bar[11];
 
     const char* motor = Motor_GetStatus() ? "ON " : "OFF";
 
@@ -344,186 +331,38 @@ static void show_dash(void)
     else if (twistActive)      mode = "TWIST";
     else if (autoActive)       mode = "AUTO";
 
-    snprintf(l0, sizeof(l0), "M:%s %s", motor, mode);
-
-    /* Compute water level from 5 probes (ADC <0.1 = submerged) */
-    int submerged = 0;
-    for (int i = 1; i <= 5; i++)
-        if (adcData.voltages[i] < 0.1f) submerged++;
-
-    const char* level =
-        (submerged>=5)?"100%":
-        (submerged==4)?"80%":
-        (submerged==3)?"60%":
-        (submerged==2)?"40%":
-        (submerged==1)?"20%":"0%";
-
-    snprintf(l1, sizeof(l1), "Water:%s", level);
+    /* row 0 first: the old row 1 still pins its glyphs while row 0 fetches */
+    bool fault = senseDryRun || senseOverLoad || senseOverUnderVolt || senseLevelFault;
 
+    snprintf(l0, sizeof(l0), "%c %s %-6s  %c%c",
+             lcd_cgram_get(Motor_GetStatus() ? GLYPH_PUMP_ON : GLYPH_PUMP_OFF),
+             motor, mode,
+             fault ? lcd_cgram_get(GLYPH_BELL) : ' ',
+             lcd_cgram_get((LcdGlyph)(GLYPH_SIG_0 + LoRa_GetLinkBars())));
     lcd_line0(l0);
-    lcd_line1(l1);
-}
-
-/***************************************************************
- *  MAIN MENU DRAW
- ***************************************************************/
-static void draw_menu_cursor(void)
-{
-    if (ui != UI_MENU) return;
 
-    uint8_t row = 255;
-    if      (menu_idx == menu_view_top)     row = 0;
-    else if (menu_idx == menu_view_top + 1) row = 1;
+    /* Water level from the active level source: tank icon + bar graph */
+    uint8_t pct  = Level_GetPercent();
+    char    tank = lcd_cgram_get((LcdGlyph)(GLYPH_TANK_0 +
+                       (pct * (LCD_GLYPH_TANK_LEVELS - 1) + 50) / 100));
 
-    if (row <= 1)
+    if (Level_IsContinuous())
     {
-        lcd_put_cur(row,0);
-        lcd_send_data(cursorVisible ? '>' : ' ');
+        dash_bar(bar, 4, pct);
+        snprintf(l1, sizeof(l1), "%c%s%3u%% %4umm", tank, bar, pct, Level_GetMm());
     }
-}
-
-static void show_menu(void)
-{
-    char l0[17], l1[17];
-
-    /* Adjust top-of-view */
-    if (menu_idx < menu_view_top)
-        menu_view_top = menu_idx;
-    else if (menu_idx > menu_view_top + 1)
-        menu_view_top = menu_idx - 1;
-
-    snprintf(l0, sizeof(l0), " %-15.15s", main_menu[menu_view_top]);
-
-    if (menu_view_top + 1 < MAIN_MENU_COUNT)
-        snprintf(l1, sizeof(l1), " %-15.15s", main_menu[menu_view_top + 1]);
-    else
-        snprintf(l1, sizeof(l1), "                ");
-
-    lcd_line0(l0);
-    lcd_line1(l1);
-
-    draw_menu_cursor();
-}
-
-/***************************************************************
- *  DEVICE SETUP MENU DRAW (scrolling cursor)
- ***************************************************************/
-static void show_devset_menu(void)
-{
-    char l0[17], l1[17];
-
-    /* Adjust top-of-view */
-    if (devset_idx < devset_view_top)
-        devset_view_top = devset_idx;
-    else if (devset_idx > devset_view_top + 1)
-        devset_view_top = devset_idx - 1;
-
-    /* Line 0 */
-    uint8_t idx0 = devset_view_top;
-    uint8_t idx1 = devset_view_top + 1;
-
-    if (idx0 < DEVSET_MENU_COUNT)
-        snprintf(l0, sizeof(l0), "%c%-15.15s",
-                 (devset_idx == idx0 ? '>' : ' '),
-                 devset_menu_items[idx0]);
-    else
-        snprintf(l0, sizeof(l0), "                ");
-
-    if (idx1 < DEVSET_MENU_COUNT)
-        snprintf(l1, sizeof(l1), "%c%-15.15s",
-                 (devset_idx == idx1 ? '>' : ' '),
-                 devset_menu_items[idx1]);
     else
-        snprintf(l1, sizeof(l1), "                ");
-
-    lcd_line0(l0);
-    lcd_line1(l1);
-}
-
-/***************************************************************
- *  TIMER MODE — TIMER SELECT
- ***************************************************************/
-static void show_timer_slot_select(void)
-{
-    lcd_clear();
-
-    /* Map page → timer indexes */
-    int item1 = timer_page * 2;
-    int item2 = item1 + 1;
-
-    char l0[17], l1[17];
-
-    /* Line0 */
-    if (item1 == 5) {
-        snprintf(l0, sizeof(l0), "%c Back",
-                 (currentSlot == 5 ? '>' : ' '));
-    }
-    else {
-        snprintf(l0, sizeof(l0), "%c Timer %d",
-                 (currentSlot == item1 ? '>' : ' '),
-                 item1 + 1);
-    }
-
-    /* Line1 */
-    if (item2 <= 5)
     {
-        if (item2 == 5) {
-            snprintf(l1, sizeof(l1), "%c Back",
-                     (currentSlot == 5 ? '>' : ' '));
-        } else {
-            snprintf(l1, sizeof(l1), "%c Timer %d",
-                     (currentSlot == item2 ? '>' : ' '),
-                     item2 + 1);
-        }
-    }
-    else {
-        snprintf(l1, sizeof(l1), "                ");
+        dash_bar(bar, 10, pct);
+        snprintf(l1, sizeof(l1), "%c%s %3u%%", tank, bar, pct);
     }
-
-    lcd_line0(l0);
     lcd_line1(l1);
 }
 
 /***************************************************************
- *  TIMER — EDIT ON TIME
- ***************************************************************/
-static void show_edit_on_time(void)
-{
-    char title[17];
-    snprintf(title, sizeof(title), "T%u On Time", (unsigned)(currentSlot + 1));
-    lcd_line0(title);
-
-    char buf[17];
-    if (time_edit_field == 0)
-        snprintf(buf, sizeof(buf), "[%02d]:%02d   Next>", edit_on_h, edit_on_m);
-    else
-        snprintf(buf, sizeof(buf), "%02d:[%02d]   Next>", edit_on_h, edit_on_m);
-
-    lcd_line1(buf);
-}
-
-/***************************************************************
- *  TIMER — EDIT OFF TIME
- ***************************************************************/
-static void show_edit_off_time(void)
-{
-    char title[17];
-    snprintf(title, sizeof(title), "T%u Off Time", (unsigned)(currentSlot + 1));
-    lcd_line0(title);
-
-    char buf[17];
-    if (time_edit_field == 0)
-        snprintf(buf, sizeof(buf), "[%02d]:%02d   Next>", edit_off_h, edit_off_m);
-    else
-        snprintf(buf, sizeof(buf), "%02d:[%02d]   Next>", edit_off_h, edit_off_m);
-
-    lcd_line1(buf);
-}
-
-/***************************************************************
- *  TIMER — DAYS MENU
+ *  TIMER — DAYS LIST (generic keys, item shows ON/OFF)
  ***************************************************************/
-static const char* dayNames[] = {
+static const char* const dayNames[] = {
     "Monday", "Tuesday", "Wed", "Thu", "Friday", "Sat", "Sun",
     "Enable All", "Disable All", "Next>"
 };
@@ -549,34 +388,6 @@ static void show_timer_days(void)
     lcd_line1(buf);
 }
 
-/***************************************************************
- *  TIMER — GAP (min)
- ***************************************************************/
-static void show_timer_gap(void)
-{
-    lcd_line0("Timer Gap (min)");
-
-    char buf[17];
-    snprintf(buf, sizeof(buf), ">T%u %3u min Next>",
-             (unsigned)(currentSlot + 1),
-             (unsigned)edit_gap_min);
-
-    lcd_line1(buf);
-}
-
-/***************************************************************
- *  TIMER — ENABLE / DISABLE
- ***************************************************************/
-static void show_timer_enable(void)
-{
-    char title[17];
-    snprintf(title, sizeof(title), "T%u Enable?",
-             (unsigned)(currentSlot + 1));
-    lcd_line0(title);
-    lcd_line1(edit_slot_enabled ? "YES       Next>" :
-                                  "NO        Next>");
-}
-
 /***************************************************************
  *  TIMER — SUMMARY
  ***************************************************************/
@@ -594,32 +405,7 @@ static void show_timer_summary(void)
 }
 
 /***************************************************************
- *  AUTO MODE (kept)
- ***************************************************************/
-static void show_auto_menu(void)
-{
-    lcd_line0("Auto Settings");
-    lcd_line1(">Gap/Max/Retry");
-}
-
-static void show_auto_gap(void){
-    lcd_line0("DRY GAP (s)");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_auto_gap_s);
-    lcd_line1(buf);
-}
-static void show_auto_maxrun(void){
-    lcd_line0("MAX RUN (min)");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_auto_maxrun_min);
-    lcd_line1(buf);
-}
-static void show_auto_retry(void){
-    lcd_line0("RETRY COUNT");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_auto_retry);
-    lcd_line1(buf);
-}
-
-/***************************************************************
- *  SEMI-AUTO UI
+ *  SEMI-AUTO / TWIST UI
  ***************************************************************/
 static void show_semi_auto(void)
 {
@@ -628,9 +414,6 @@ static void show_semi_auto(void)
                              : "val:Enable  Next>");
 }
 
-/***************************************************************
- *  TWIST MODE UI
- ***************************************************************/
 static void show_twist(void)
 {
     char l0[17];
@@ -643,37 +426,6 @@ static void show_twist(void)
                             "val:START  Next>");
 }
 
-static void show_twist_on_sec(void){
-    lcd_line0("TWIST ON SEC");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_twist_on_s);
-    lcd_line1(buf);
-}
-static void show_twist_off_sec(void){
-    lcd_line0("TWIST OFF SEC");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_twist_off_s);
-    lcd_line1(buf);
-}
-static void show_twist_on_h(void){
-    lcd_line0("TWIST ON HH");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_twist_on_hh);
-    lcd_line1(buf);
-}
-static void show_twist_on_m(void){
-    lcd_line0("TWIST ON MM");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_twist_on_mm);
-    lcd_line1(buf);
-}
-static void show_twist_off_h(void){
-    lcd_line0("TWIST OFF HH");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_twist_off_hh);
-    lcd_line1(buf);
-}
-static void show_twist_off_m(void){
-    lcd_line0("TWIST OFF MM");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_twist_off_mm);
-    lcd_line1(buf);
-}
-
 /***************************************************************
  *  COUNTDOWN UI
  ***************************************************************/
@@ -701,205 +453,51 @@ static void show_countdown(void)
     lcd_line1(l1);
 }
 
-static void show_countdown_edit_min(void){
-    lcd_line0("SET MINUTES");
-    char buf[17]; snprintf(buf,sizeof(buf),"val:%03u Next>",edit_countdown_min);
-    lcd_line1(buf);
-}
-
-/***************************************************************
- *  DEVICE SETUP (SETTINGS) UI
- ***************************************************************/
-/* Dry Run: 0=Disable, 1..15 min */
-static void show_settings_gap(void){
-    lcd_line0("Set Dry Run");
-    char buf[17];
-    if (edit_settings_gap_s == 0)
-        snprintf(buf,sizeof(buf),"Disable    Next>");
-    else
-        snprintf(buf,sizeof(buf),"val:%2umin Next>", edit_settings_gap_s);
-    lcd_line1(buf);
-}
-
-/* Testing Gap: 0=Disable, 1..180min */
-static void show_settings_retry(void){
-    lcd_line0("Testing Gap");
-    char buf[17];
-    if (edit_settings_retry == 0)
-        snprintf(buf,sizeof(buf),"Disable    Next>");
-    else
-        snprintf(buf,sizeof(buf),"val:%3umin Next>", edit_settings_retry);
-    lcd_line1(buf);
-}
-
-/* Low Volt: 0=Disable, else 150–200V */
-static void show_settings_uv(void){
-    lcd_line0("Set Low Volt");
-    char buf[17];
-    if (edit_settings_uv == 0)
-        snprintf(buf,sizeof(buf),"Disable    Next>");
-    else
-        snprintf(buf,sizeof(buf),"val:%3uV Next>", edit_settings_uv);
-    lcd_line1(buf);
-}
-
-/* High Volt: 0=Disable, else 250–300V */
-static void show_settings_ov(void){
-    lcd_line0("Set High Volt");
-    char buf[17];
-    if (edit_settings_ov == 0)
-        snprintf(buf,sizeof(buf),"Disable    Next>");
-    else
-        snprintf(buf,sizeof(buf),"val:%3uV Next>", edit_settings_ov);
-    lcd_line1(buf);
-}
-
-/* Over Load: 0=Disable, else up to 25A */
-/* Over Load: 0=Disable, else up to 25A */
-static void show_settings_ol(void){
-    lcd_line0("Over Load (A)");
-    char buf[17];
-    if (edit_settings_ol < 1)
-        snprintf(buf, sizeof(buf), "Disable    Next>");
-    else
-        snprintf(buf, sizeof(buf), "val:%3d Next>", edit_settings_ol);
-    lcd_line1(buf);
-}
-/* Under Load: 0=Disable, else up to 10A */
-/* Under Load: 0=Disable, else up to 10A */
-static void show_settings_ul(void){
-    lcd_line0("Under Load (A)");
-    char buf[17];
-    if (edit_settings_ul < 1)
-        snprintf(buf, sizeof(buf), "Disable    Next>");
-    else
-        snprintf(buf, sizeof(buf), "val:%3d Next>", edit_settings_ul);
-    lcd_line1(buf);
-}
-
-/* Max Run: 0=Disable, else 10–300min */
-static void show_settings_maxrun(void){
-    lcd_line0("Set Max Run");
-    char buf[17];
-    if (edit_settings_maxrun == 0)
-        snprintf(buf,sizeof(buf),"Disable    Next>");
-    else
-        snprintf(buf,sizeof(buf),"val:%3umin Next>",edit_settings_maxrun);
-    lcd_line1(buf);
-}
-
-/* Power Restore: YES / NO / LAST */
-static void show_settings_pwrrest(void){
-    lcd_line0("Power Restore");
-    const char* text =
-        (edit_settings_pwrrest == 0) ? "YES       Next>" :
-        (edit_settings_pwrrest == 1) ? "NO        Next>" :
-                                       "LAST      Next>";
-    lcd_line1(text);
-}
-
-static void show_settings_factory(void){
-    lcd_line0("Factory Reset?");
-    lcd_line1(edit_settings_factory_yes ? "YES       Next>" :
-                                         "NO        Next>");
-}
-
 /***************************************************************
- *  DEVICE SETUP — DATE/TIME/DAY SCREENS
+ *  ADD NEW DEVICE — PAIRED / REMOVED
  ***************************************************************/
-static void show_devset_edit_date(void)
-{
-    lcd_line0("Set Date");
-
-    uint8_t yy2 = (uint8_t)(edit_date_yyyy % 100);
-    char buf[17];
-
-    if (edit_date_field == 0)
-        snprintf(buf,sizeof(buf),"[%02u]-%02u-%02u", edit_date_dd, edit_date_mm, yy2);
-    else if (edit_date_field == 1)
-        snprintf(buf,sizeof(buf),"%02u-[%02u]-%02u", edit_date_dd, edit_date_mm, yy2);
-    else
-        snprintf(buf,sizeof(buf),"%02u-%02u-[%02u]", edit_date_dd, edit_date_mm, yy2);
-
-    lcd_line1(buf);
-}
-
-static void show_devset_edit_time(void)
-{
-    lcd_line0("Set Time");
-    char buf[17];
-
-    if (edit_time_field == 0)
-        snprintf(buf,sizeof(buf),"[%02u]:%02u", edit_time_hh, edit_time_min);
-    else
-        snprintf(buf,sizeof(buf),"%02u:[%02u]", edit_time_hh, edit_time_min);
-
-    lcd_line1(buf);
-}
-
-static void show_devset_edit_day(void)
+static void show_add_device_done(void)
 {
-    lcd_line0("Set Day");
+    lcd_line0(lastAddActionPair ? "Paired Device" : "Removed Device");
     char buf[17];
-    snprintf(buf,sizeof(buf),"> %s", dowNames[edit_day_idx2 % 7]);
+    snprintf(buf,sizeof(buf),"%s   OK>", addDevTypeNames[lastAddDevType]);
     lcd_line1(buf);
 }
 
 /***************************************************************
- *  ADD NEW DEVICE — UI
+ *  ENERGY METER PAGES
  ***************************************************************/
-static void show_add_device_menu(void)
+static void show_meter(void)
 {
-    lcd_line0(addDevMenuIndex == 0 ? ">Pair Device" : " Pair Device");
-    lcd_line1(addDevMenuIndex == 1 ? ">Remove Device" : " Remove Device");
-}
-
-static void show_add_device_pair(void)
-{
-    lcd_line0("Pair Device");
-    char buf[17];
-    snprintf(buf,sizeof(buf),">%s", addDevTypeNames[addDevTypeIndex]);
-    lcd_line1(buf);
-}
+    const MeterReadings *m = Meter_Get();
+    char l0[17], l1[17];
 
-static void show_add_device_remove(void)
-{
-    lcd_line0("Remove Device");
-    char buf[17];
-    snprintf(buf,sizeof(buf),">%s", addDevTypeNames[addDevTypeIndex]);
-    lcd_line1(buf);
-}
+    switch (meter_page)
+    {
+        case 0:   /* live power */
+            snprintf(l0, sizeof(l0), "P:%4.0fW PF:%4.2f", m->activeW, m->pf);
+            snprintf(l1, sizeof(l1), "S:%4.0fVA %3.0fV", m->apparentVA, g_voltageV);
+            break;
 
-static void show_add_device_pair_done(void)
-{
-    lcd_line0("Paired Device");
-    char buf[17];
-    snprintf(buf,sizeof(buf),"%s   OK>", addDevTypeNames[lastAddDevType]);
-    lcd_line1(buf);
-}
+        case 1:   /* run + today */
+            snprintf(l0, sizeof(l0), "Run:%7.3fkWh", m->runWh / 1000.0f);
+            snprintf(l1, sizeof(l1), "Day:%7.3fkWh", m->dayWh / 1000.0f);
+            break;
 
-static void show_add_device_remove_done(void)
-{
-    lcd_line0("Removed Device");
-    char buf[17];
-    snprintf(buf,sizeof(buf),"%s   OK>", addDevTypeNames[lastAddDevType]);
-    lcd_line1(buf);
-}
+        default:  /* lifetime */
+            snprintf(l0, sizeof(l0), "Total Energy");
+            snprintf(l1, sizeof(l1), "%10.3f kWh", m->lifeWh / 1000.0f);
+            break;
+    }
 
-/***************************************************************
- *  RESET TO DEFAULT — CONFIRM
- ***************************************************************/
-static void show_reset_confirm(void)
-{
-    lcd_line0("Reset To Default?");
-    lcd_line1(reset_confirm_yes ? "YES       Apply>" :
-                                  "NO        Back>");
+    lcd_line0(l0);
+    lcd_line1(l1);
 }
 
 /* ================================================================
    APPLY FUNCTIONS
    ================================================================ */
-static void apply_timer_slot(void)
+static UiState apply_timer_slot(void)
 {
     TimerSlot *t = &timerSlots[currentSlot];
 
@@ -913,19 +511,21 @@ static void apply_timer_slot(void)
 
     extern void ModelHandle_TimerRecalculateNow(void);
     ModelHandle_TimerRecalculateNow();
+    return UI_NONE;
 }
 
-static void apply_auto_settings(void)
+static UiState apply_auto_settings(void)
 {
     ModelHandle_SetAutoSettings(
         edit_auto_gap_s,
         edit_auto_maxrun_min,
         edit_auto_retry
     );
+    return UI_NONE;
 }
 
 /* Apply current Device Setup core settings into model */
-static void apply_settings_core(void)
+static UiState apply_settings_core(void)
 {
     /* Convert UI dry-run minutes to seconds; 0 = disabled */
     uint16_t gap_s = 0;
@@ -941,32 +541,143 @@ static void apply_settings_core(void)
         edit_settings_ul,
         edit_settings_maxrun
     );
+    return UI_NONE;
 }
 
-/***************************************************************
- *  SETTINGS FLOW — START (Device Setup)
- *  Load all values + RTC into local edit variables and go to
- *  Device Setup scroll menu.
- ***************************************************************/
-static void start_settings_edit_flow(void)
+static UiState apply_pwrrest(void)
 {
-    /* Load fresh settings from model */
-    uint16_t gap_s = ModelHandle_GetGapTime();
-    if (gap_s == 0) {
-        edit_settings_gap_s = 0;
-    } else {
-        edit_settings_gap_s = gap_s / 60;
-        if (edit_settings_gap_s < 1)  edit_settings_gap_s = 1;
-        if (edit_settings_gap_s > 15) edit_settings_gap_s = 15;
-    }
+    ModelHandle_SetPowerRestoreMode(edit_settings_pwrrest);
+    return UI_NONE;
+}
 
-    edit_settings_retry   = ModelHandle_GetRetryCount();
-    if (edit_settings_retry > 180)
-        edit_settings_retry = 180;
+static UiState apply_factory(void)
+{
+    if (edit_settings_factory_yes)
+        ModelHandle_FactoryReset();
+    return UI_NONE;
+}
 
-    edit_settings_uv      = ModelHandle_GetUnderVolt();
-    if (edit_settings_uv != 0) {    // 0=Disable
-        if (edit_settings_uv < 150) edit_settings_uv = 150;
+static UiState apply_reset_confirm(void)
+{
+    if (reset_confirm_yes)
+        ModelHandle_FactoryReset();
+    return UI_NONE;
+}
+
+/* RTC keeps every field the editor does not own */
+static UiState apply_date(void)
+{
+    RTC_GetTimeDate();
+    RTC_SetTimeDate(time.sec, time.min, time.hour, time.dow,
+                    edit_date_dd, edit_date_mm, edit_date_yyyy);
+    RTC_GetTimeDate();
+    return UI_NONE;
+}
+
+static UiState apply_time(void)
+{
+    RTC_GetTimeDate();
+    RTC_SetTimeDate(time.sec, edit_time_min, edit_time_hh, time.dow,
+                    time.dom, time.month, time.year);
+    RTC_GetTimeDate();
+    return UI_NONE;
+}
+
+static UiState apply_day(void)
+{
+    RTC_GetTimeDate();
+    /* DS1307 DOW 1..7 */
+    RTC_SetTimeDate(time.sec, time.min, time.hour,
+                    (uint8_t)((edit_day_idx2 % 7) + 1),
+                    time.dom, time.month, time.year);
+    RTC_GetTimeDate();
+    return UI_NONE;
+}
+
+static UiState toggle_semi_auto(void)
+{
+    if (!semiAutoActive)
+        ModelHandle_StartSemiAuto();
+    else
+        ModelHandle_StopSemiAuto();
+    return UI_NONE;
+}
+
+/* running: stop and leave; stopped: go through the editors first */
+static UiState twist_select(void)
+{
+    if (!twistActive)
+        return UI_TWIST_EDIT_ON;
+
+    extern void ModelHandle_StopTwist(void);
+    ModelHandle_StopTwist();
+    return UI_NONE;
+}
+
+static UiState apply_twist(void)
+{
+    extern void ModelHandle_StartTwist(uint16_t on_s, uint16_t off_s,
+                                       uint8_t onH, uint8_t onM,
+                                       uint8_t offH, uint8_t offM);
+    ModelHandle_StartTwist(edit_twist_on_s, edit_twist_off_s,
+                           edit_twist_on_hh, edit_twist_on_mm,
+                           edit_twist_off_hh, edit_twist_off_mm);
+    return UI_NONE;
+}
+
+/* ================================================================
+   LIST HOOKS — run on SELECT, before the item's target
+   ================================================================ */
+static void enter_timer(uint8_t i)
+{
+    (void)i;
+    currentSlot = 0;
+}
+
+static void enter_add_device(uint8_t i)
+{
+    (void)i;
+    addDevMenuIndex = 0;
+}
+
+static void enter_meter(uint8_t i)
+{
+    (void)i;
+    meter_page = 0;
+}
+
+static void enter_reset_confirm(uint8_t i)
+{
+    (void)i;
+    reset_confirm_yes = false;
+}
+
+/***************************************************************
+ *  SETTINGS FLOW — START (Device Setup)
+ *  Load all values + RTC into local edit variables before the
+ *  Device Setup scroll menu opens.
+ ***************************************************************/
+static void enter_devset(uint8_t i)
+{
+    (void)i;
+
+    /* Load fresh settings from model */
+    uint16_t gap_s = ModelHandle_GetGapTime();
+    if (gap_s == 0) {
+        edit_settings_gap_s = 0;
+    } else {
+        edit_settings_gap_s = gap_s / 60;
+        if (edit_settings_gap_s < 1)  edit_settings_gap_s = 1;
+        if (edit_settings_gap_s > 15) edit_settings_gap_s = 15;
+    }
+
+    edit_settings_retry   = ModelHandle_GetRetryCount();
+    if (edit_settings_retry > 180)
+        edit_settings_retry = 180;
+
+    edit_settings_uv      = ModelHandle_GetUnderVolt();
+    if (edit_settings_uv != 0) {    // 0=Disable
+        if (edit_settings_uv < 150) edit_settings_uv = 150;
         if (edit_settings_uv > 200) edit_settings_uv = 200;
     }
 
@@ -996,11 +707,9 @@ static void start_settings_edit_flow(void)
     edit_date_dd    = time.dom;
     edit_date_mm    = time.month;
     edit_date_yyyy  = time.year;
-    edit_date_field = 0;
 
     edit_time_hh    = time.hour;
     edit_time_min   = time.min;
-    edit_time_field = 0;
 
     /* DS1307 dow: 1..7; map to 0..6 index (Sun..Sat) */
     if (time.dow >= 1 && time.dow <= 7)
@@ -1008,380 +717,582 @@ static void start_settings_edit_flow(void)
     else
         edit_day_idx2 = 0;
 
-    devset_idx      = 0;
-    devset_view_top = 0;
-
-    ui = UI_DEVSET_MENU;
-    screenNeedsRefresh = true;
+    devset_idx = 0;
 }
 
-/***************************************************************
- *  MENU SELECT — MAIN NAVIGATION + TIMER / SETTINGS
- ***************************************************************/
-static void goto_menu_top(void)
+/* TIMER SLOT SELECT → LOAD TIMER */
+static void load_timer_slot(uint8_t i)
 {
-    menu_idx = 0;
-    menu_view_top = 0;
-}
+    TimerSlot *t = &timerSlots[i];
 
-static void menu_select(void)
-{
-    refreshInactivityTimer();
+    edit_on_h  = t->onHour;
+    edit_on_m  = t->onMinute;
+    edit_off_h = t->offHour;
+    edit_off_m = t->offMinute;
 
-    /* WELCOME → DASH */
-    if (ui == UI_WELCOME)
-    {
-        ui = UI_DASH;
-        screenNeedsRefresh = true;
-        return;
-    }
+    edit_day_mask = t->dayMask;
+    edit_gap_min  = t->gapMinutes;
+    edit_slot_enabled = t->enabled;
 
-    /* DASH → MENU (also handled via long SELECT) */
-    if (ui == UI_DASH)
-    {
-        goto_menu_top();
-        ui = UI_MENU;
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* MAIN MENU */
-    if (ui == UI_MENU)
-    {
-        switch(menu_idx)
-        {
-            case 0:   /* TIMER SETTING */
-                currentSlot = 0;
-                timer_page  = 0;
-                ui = UI_TIMER_SLOT_SELECT;
-                screenNeedsRefresh = true;
-                return;
-
-            case 1:   /* ADD NEW DEVICE */
-                addDevMenuIndex = 0;
-                addDevTypeIndex = 0;
-                ui = UI_ADD_DEVICE_MENU;
-                screenNeedsRefresh = true;
-                return;
-
-            case 2:   /* DEVICE SETUP */
-                start_settings_edit_flow();  /* sets ui = UI_DEVSET_MENU */
-                return;
-
-            case 3:   /* RESET TO DEFAULT CONFIRM */
-                reset_confirm_yes = false;
-                ui = UI_RESET_CONFIRM;
-                screenNeedsRefresh = true;
-                return;
-        }
-    }
+    edit_day_index  = 0;
+}
 
-    /* TIMER SLOT SELECT → LOAD TIMER */
-    if (ui == UI_TIMER_SLOT_SELECT)
-    {
-        if (currentSlot == 5)
-        {
-            ui = UI_MENU;  // BACK
-            screenNeedsRefresh = true;
-            return;
-        }
+static void day_toggle(uint8_t i)  { edit_day_mask ^= (uint8_t)(1u << i); }
+static void days_all(uint8_t i)    { (void)i; edit_day_mask = 0x7F; }
+static void days_none(uint8_t i)   { (void)i; edit_day_mask = 0x00; }
 
-        TimerSlot *t = &timerSlots[currentSlot];
+static void add_dev_type(uint8_t i)
+{
+    addDevTypeIndex = 0;
+    lastAddActionPair = (i == 0);
+}
 
-        edit_on_h  = t->onHour;
-        edit_on_m  = t->onMinute;
-        edit_off_h = t->offHour;
-        edit_off_m = t->offMinute;
+static void pair_pick(uint8_t i)
+{
+    lastAddActionPair = true;
+    lastAddDevType = i;
+}
 
-        edit_day_mask = t->dayMask;
-        edit_gap_min  = t->gapMinutes;
-        edit_slot_enabled = t->enabled;
+static void remove_pick(uint8_t i)
+{
+    lastAddActionPair = false;
+    lastAddDevType = i;
+}
 
-        time_edit_field = 0;
-        edit_day_index  = 0;
+/* ================================================================
+   MENU ENGINE — DESCRIPTORS
+   Every list and editor is one const UiScreen in flash, indexed
+   by UiState. The engine below draws it and maps the buttons:
+     LIST : UP/DOWN move, SELECT picks (hook, then target),
+            RESET → back
+     EDIT : UP/DOWN step the current field, SELECT moves to the
+            next field; after the last one done() → next,
+            RESET → back (nothing applied)
+     VIEW : draw() only; keys go to key() or the dashboard
+   Holding UP/DOWN repeats the step every CONTINUOUS_STEP_MS.
+   A new setting is one UiField + one table entry.
+   ================================================================ */
+typedef enum { SCR_VIEW = 0, SCR_LIST, SCR_EDIT } ScrKind;
+
+#define SCR_F_WRAP      0x01    // LIST: cursor wraps around
+#define SCR_F_BLINK     0x02    // LIST: blinking '>' cursor
+
+enum { UI_VT_U8 = 0, UI_VT_U16, UI_VT_INT, UI_VT_BOOL };
+
+#define UI_VF_WRAP      0x01    // max → min and back
+#define UI_VF_DISABLE   0x02    // 0 is shown as "Disable"
+#define UI_VF_OFF_GAP   0x04    // 0 sits just below min (0 ↔ min)
+#define UI_VF_YY        0x08    // shown modulo 100
+
+typedef struct {
+    void              *val;
+    uint8_t            type;        // UI_VT_*
+    uint8_t            flags;       // UI_VF_*
+    uint8_t            step;        // 0 = 1
+    int16_t            min, max;
+    const char* const *names;       // value → text, NULL = number
+} UiField;
+
+typedef struct {
+    const char *label;
+    uint8_t     target;             // UiState, UI_NONE = stay on the list
+    void      (*hook)(uint8_t i);
+} UiItem;
+
+typedef struct {
+    uint8_t         kind;           // ScrKind
+    uint8_t         flags;          // SCR_F_*
+    uint8_t         count;          // items / fields
+    uint8_t         next;           // UiState after done()
+    uint8_t         back;           // UiState on RESET
+    const char     *title;          // row 0, "%u" = timer slot number
+    /* EDIT row 1, printf of the single field (or its name);
+       several fields: fmt[0] separates them, fmt+1 follows */
+    const char     *fmt;
+    const UiField  *fields;
+    const UiItem   *items;
+    uint8_t        *idx;            // LIST cursor
+    UiState       (*done)(void);    // EDIT; UI_NONE → next
+    void          (*draw)(void);    // replaces the generic renderer
+    void          (*key)(UiButton b);
+} UiScreen;
+
+#define FIELD(v, t, f, lo, hi)   { (v), (t), (f), 1, (lo), (hi), NULL }
+#define CHOICE(v, t, n, f)       { (v), (t), (f), 1, 0, (int16_t)(sizeof(n)/sizeof(n[0]) - 1), (n) }
+#define ITEMS(a)                 .items = (a), .count = sizeof(a)/sizeof(a[0])
+#define FIELDS(a)                .fields = (a), .count = sizeof(a)/sizeof(a[0])
+
+static const char* const yesNo[]   = { "NO", "YES" };
+static const char* const pwrRest[] = { "YES", "NO", "LAST" };
+static const char* const confirm[] = { "NO        Back>", "YES       Apply>" };
+
+/* ---- lists ---- */
+static const UiItem mainMenuItems[] = {
+    { "Timer Setting",    UI_TIMER_SLOT_SELECT, enter_timer         },
+    { "Add New Device",   UI_ADD_DEVICE_MENU,   enter_add_device    },
+    { "Device Setup",     UI_DEVSET_MENU,       enter_devset        },
+    { "Energy Meter",     UI_METER,             enter_meter         },
+    { "Reset To Default", UI_RESET_CONFIRM,     enter_reset_confirm },
+};
 
-        ui = UI_TIMER_EDIT_ON_TIME;
-        screenNeedsRefresh = true;
-        return;
-    }
+static const UiItem timerSlotItems[] = {
+    { "Timer 1", UI_TIMER_EDIT_ON_TIME, load_timer_slot },
+    { "Timer 2", UI_TIMER_EDIT_ON_TIME, load_timer_slot },
+    { "Timer 3", UI_TIMER_EDIT_ON_TIME, load_timer_slot },
+    { "Timer 4", UI_TIMER_EDIT_ON_TIME, load_timer_slot },
+    { "Timer 5", UI_TIMER_EDIT_ON_TIME, load_timer_slot },
+    { "Back",    UI_MENU,               NULL            },
+};
 
-    /* TIMER EDIT FLOW SEQUENCE */
-    switch(ui)
-    {
-        case UI_TIMER_EDIT_ON_TIME:
-            if (time_edit_field == 0)
-                time_edit_field = 1;
-            else {
-                time_edit_field = 0;
-                ui = UI_TIMER_EDIT_OFF_TIME;
-            }
-            break;
+static const UiItem timerDayItems[] = {
+    { "Monday",      UI_NONE, day_toggle }, { "Tuesday", UI_NONE, day_toggle },
+    { "Wed",         UI_NONE, day_toggle }, { "Thu",     UI_NONE, day_toggle },
+    { "Friday",      UI_NONE, day_toggle }, { "Sat",     UI_NONE, day_toggle },
+    { "Sun",         UI_NONE, day_toggle },
+    { "Enable All",  UI_NONE, days_all   },
+    { "Disable All", UI_NONE, days_none  },
+    { "Next>",       UI_TIMER_EDIT_GAP, NULL },
+};
 
-        case UI_TIMER_EDIT_OFF_TIME:
-            if (time_edit_field == 0)
-                time_edit_field = 1;
-            else {
-                time_edit_field = 0;
-                ui = UI_TIMER_EDIT_DAYS;
-            }
-            break;
+static const UiItem devsetItems[] = {
+    { "Set Dry Run",     UI_SETTINGS_GAP,     NULL },
+    { "Set Testing Gap", UI_SETTINGS_RETRY,   NULL },
+    { "Set Low Volt",    UI_SETTINGS_UV,      NULL },
+    { "Set High Volt",   UI_SETTINGS_OV,      NULL },
+    { "Set Over Load",   UI_SETTINGS_OL,      NULL },
+    { "Set Under Load",  UI_SETTINGS_UL,      NULL },
+    { "Set Max Run",     UI_SETTINGS_MAXRUN,  NULL },
+    { "Set Date",        UI_DEVSET_EDIT_DATE, NULL },
+    { "Set Time",        UI_DEVSET_EDIT_TIME, NULL },
+    { "Set Day",         UI_DEVSET_EDIT_DAY,  NULL },
+    { "Power Restore",   UI_SETTINGS_PWRREST, NULL },
+    { "Factory Reset",   UI_SETTINGS_FACTORY, NULL },
+    { "Back",            UI_MENU,             NULL },
+};
 
-        case UI_TIMER_EDIT_DAYS:
-            if (edit_day_index == 9)
-                ui = UI_TIMER_EDIT_GAP;
-            else
-                edit_day_index++;
-            break;
+static const UiItem addDevItems[] = {
+    { "Pair Device",   UI_ADD_DEVICE_PAIR,   add_dev_type },
+    { "Remove Device", UI_ADD_DEVICE_REMOVE, add_dev_type },
+};
 
-        case UI_TIMER_EDIT_GAP:
-            ui = UI_TIMER_EDIT_ENABLE;
-            break;
+static const UiItem pairItems[] = {
+    { "Wi-Fi",       UI_ADD_DEVICE_PAIR_DONE, pair_pick },
+    { "Receiver",    UI_ADD_DEVICE_PAIR_DONE, pair_pick },
+    { "Transmitter", UI_ADD_DEVICE_PAIR_DONE, pair_pick },
+};
 
-        case UI_TIMER_EDIT_ENABLE:
-            ui = UI_TIMER_EDIT_SUMMARY;
-            break;
+static const UiItem removeItems[] = {
+    { "Wi-Fi",       UI_ADD_DEVICE_REMOVE_DONE, remove_pick },
+    { "Receiver",    UI_ADD_DEVICE_REMOVE_DONE, remove_pick },
+    { "Transmitter", UI_ADD_DEVICE_REMOVE_DONE, remove_pick },
+};
 
-        case UI_TIMER_EDIT_SUMMARY:
-            apply_timer_slot();
-            ui = UI_TIMER_SLOT_SELECT;   /* after summary → back to slot select */
-            break;
+/* ---- fields ---- */
+static const UiField fOnTime[]  = { FIELD(&edit_on_h,  UI_VT_U8, 0, 0, 23), FIELD(&edit_on_m,  UI_VT_U8, 0, 0, 59) };
+static const UiField fOffTime[] = { FIELD(&edit_off_h, UI_VT_U8, 0, 0, 23), FIELD(&edit_off_m, UI_VT_U8, 0, 0, 59) };
+static const UiField fGap[]     = { FIELD(&edit_gap_min, UI_VT_U8, 0, 0, 240) };   // limit 4 hours
+static const UiField fEnable[]  = { CHOICE(&edit_slot_enabled, UI_VT_BOOL, yesNo, 0) };
+
+static const UiField fAutoGap[]    = { FIELD(&edit_auto_gap_s,      UI_VT_U16, 0, 0, 999) };
+static const UiField fAutoMaxrun[] = { FIELD(&edit_auto_maxrun_min, UI_VT_U16, 0, 0, 999) };
+static const UiField fAutoRetry[]  = { FIELD(&edit_auto_retry,      UI_VT_U16, 0, 0, 999) };
+
+static const UiField fTwistOn[]   = { FIELD(&edit_twist_on_s,   UI_VT_U16, 0, 0, 999) };
+static const UiField fTwistOff[]  = { FIELD(&edit_twist_off_s,  UI_VT_U16, 0, 0, 999) };
+static const UiField fTwistOnH[]  = { FIELD(&edit_twist_on_hh,  UI_VT_U8,  0, 0, 23)  };
+static const UiField fTwistOnM[]  = { FIELD(&edit_twist_on_mm,  UI_VT_U8,  0, 0, 59)  };
+static const UiField fTwistOffH[] = { FIELD(&edit_twist_off_hh, UI_VT_U8,  0, 0, 23)  };
+static const UiField fTwistOffM[] = { FIELD(&edit_twist_off_mm, UI_VT_U8,  0, 0, 59)  };
+
+static const UiField fCountdown[] = { FIELD(&edit_countdown_min, UI_VT_U16, 0, 1, 999) };
+
+static const UiField fSetGap[]    = { FIELD(&edit_settings_gap_s,  UI_VT_U16, UI_VF_DISABLE, 0, 15)  };
+static const UiField fSetRetry[]  = { FIELD(&edit_settings_retry,  UI_VT_U8,  UI_VF_DISABLE, 0, 180) };
+static const UiField fSetUv[]     = { FIELD(&edit_settings_uv,     UI_VT_U16, UI_VF_DISABLE | UI_VF_OFF_GAP, 150, 200) };
+static const UiField fSetOv[]     = { FIELD(&edit_settings_ov,     UI_VT_U16, UI_VF_DISABLE | UI_VF_OFF_GAP, 250, 300) };
+static const UiField fSetOl[]     = { FIELD(&edit_settings_ol,     UI_VT_INT, UI_VF_DISABLE, 0, 25)  };
+static const UiField fSetUl[]     = { FIELD(&edit_settings_ul,     UI_VT_INT, UI_VF_DISABLE, 0, 10)  };
+static const UiField fSetMaxrun[] = { FIELD(&edit_settings_maxrun, UI_VT_U16, UI_VF_DISABLE | UI_VF_OFF_GAP, 10, 300) };
+static const UiField fSetPwr[]    = { CHOICE(&edit_settings_pwrrest, UI_VT_U8, pwrRest, UI_VF_WRAP) };
+static const UiField fSetFactory[]= { CHOICE(&edit_settings_factory_yes, UI_VT_BOOL, yesNo, 0) };
+
+static const UiField fDate[] = {
+    FIELD(&edit_date_dd,   UI_VT_U8,  0, 1, 31),
+    FIELD(&edit_date_mm,   UI_VT_U8,  0, 1, 12),
+    FIELD(&edit_date_yyyy, UI_VT_U16, UI_VF_YY, 2020, 2099),
+};
+static const UiField fTime[] = {
+    FIELD(&edit_time_hh,  UI_VT_U8, 0, 0, 23),
+    FIELD(&edit_time_min, UI_VT_U8, 0, 0, 59),
+};
+static const UiField fDay[]     = { CHOICE(&edit_day_idx2, UI_VT_U8, dowNames, UI_VF_WRAP) };
+static const UiField fConfirm[] = { CHOICE(&reset_confirm_yes, UI_VT_BOOL, confirm, 0) };
+
+static void meter_key(UiButton b);
+
+#define VAL_NEXT   "val:%03u Next>"
+#define SETTING(f, t, fm, d) \
+    { .kind = SCR_EDIT, .title = (t), .fmt = (fm), FIELDS(f), .done = (d), \
+      .next = UI_DEVSET_MENU, .back = UI_DEVSET_MENU }
+#define TWIST_EDIT(f, t, n, d) \
+    { .kind = SCR_EDIT, .title = (t), .fmt = VAL_NEXT, FIELDS(f), .done = (d), \
+      .next = (n), .back = UI_MENU }
+
+static const UiScreen s_screens[UI_NONE] = {
+    [UI_WELCOME] = { .kind = SCR_VIEW, .draw = show_welcome },
+    [UI_DASH]    = { .kind = SCR_VIEW, .draw = show_dash },
+    [UI_METER]   = { .kind = SCR_VIEW, .draw = show_meter, .key = meter_key },
+    [UI_COUNTDOWN] = { .kind = SCR_VIEW, .draw = show_countdown },
+
+    [UI_MENU] = { .kind = SCR_LIST, .flags = SCR_F_BLINK, ITEMS(mainMenuItems),
+                  .idx = &menu_idx, .back = UI_DASH },
+
+    /* TIMER: slot → on → off → days → gap → enable → summary → slot */
+    [UI_TIMER_SLOT_SELECT]  = { .kind = SCR_LIST, ITEMS(timerSlotItems),
+                                .idx = &currentSlot, .back = UI_MENU },
+    [UI_TIMER_EDIT_ON_TIME] = { .kind = SCR_EDIT, .title = "T%u On Time", .fmt = ":   Next>",
+                                FIELDS(fOnTime), .next = UI_TIMER_EDIT_OFF_TIME,
+                                .back = UI_TIMER_SLOT_SELECT },
+    [UI_TIMER_EDIT_OFF_TIME]= { .kind = SCR_EDIT, .title = "T%u Off Time", .fmt = ":   Next>",
+                                FIELDS(fOffTime), .next = UI_TIMER_EDIT_DAYS,
+                                .back = UI_TIMER_SLOT_SELECT },
+    [UI_TIMER_EDIT_DAYS]    = { .kind = SCR_LIST, .flags = SCR_F_WRAP, ITEMS(timerDayItems),
+                                .idx = &edit_day_index, .back = UI_TIMER_SLOT_SELECT,
+                                .draw = show_timer_days },
+    [UI_TIMER_EDIT_GAP]     = { .kind = SCR_EDIT, .title = "Timer Gap (min)",
+                                .fmt = ">%3u min   Next>", FIELDS(fGap),
+                                .next = UI_TIMER_EDIT_ENABLE, .back = UI_TIMER_SLOT_SELECT },
+    [UI_TIMER_EDIT_ENABLE]  = { .kind = SCR_EDIT, .title = "T%u Enable?", .fmt = "%-10sNext>",
+                                FIELDS(fEnable), .next = UI_TIMER_EDIT_SUMMARY,
+                                .back = UI_TIMER_SLOT_SELECT },
+    [UI_TIMER_EDIT_SUMMARY] = { .kind = SCR_EDIT, .done = apply_timer_slot,
+                                .next = UI_TIMER_SLOT_SELECT, .back = UI_TIMER_SLOT_SELECT,
+                                .draw = show_timer_summary },
+
+    /* AUTO (kept for future use) */
+    [UI_AUTO_MENU]        = { .kind = SCR_EDIT, .title = "Auto Settings", .fmt = ">Gap/Max/Retry",
+                              .next = UI_AUTO_EDIT_GAP, .back = UI_MENU },
+    [UI_AUTO_EDIT_GAP]    = { .kind = SCR_EDIT, .title = "DRY GAP (s)", .fmt = VAL_NEXT,
+                              FIELDS(fAutoGap), .next = UI_AUTO_EDIT_MAXRUN, .back = UI_MENU },
+    [UI_AUTO_EDIT_MAXRUN] = { .kind = SCR_EDIT, .title = "MAX RUN (min)", .fmt = VAL_NEXT,
+                              FIELDS(fAutoMaxrun), .next = UI_AUTO_EDIT_RETRY, .back = UI_MENU },
+    [UI_AUTO_EDIT_RETRY]  = { .kind = SCR_EDIT, .title = "RETRY COUNT", .fmt = VAL_NEXT,
+                              FIELDS(fAutoRetry), .done = apply_auto_settings,
+                              .next = UI_MENU, .back = UI_MENU },
+
+    [UI_SEMI_AUTO] = { .kind = SCR_EDIT, .done = toggle_semi_auto, .next = UI_DASH,
+                       .back = UI_MENU, .draw = show_semi_auto },
+
+    /* TWIST: start → on s → off s → on hh:mm → off hh:mm → run */
+    [UI_TWIST]           = { .kind = SCR_EDIT, .done = twist_select, .next = UI_DASH,
+                             .back = UI_MENU, .draw = show_twist },
+    [UI_TWIST_EDIT_ON]   = TWIST_EDIT(fTwistOn,   "TWIST ON SEC",  UI_TWIST_EDIT_OFF,   NULL),
+    [UI_TWIST_EDIT_OFF]  = TWIST_EDIT(fTwistOff,  "TWIST OFF SEC", UI_TWIST_EDIT_ON_H,  NULL),
+    [UI_TWIST_EDIT_ON_H] = TWIST_EDIT(fTwistOnH,  "TWIST ON HH",   UI_TWIST_EDIT_ON_M,  NULL),
+    [UI_TWIST_EDIT_ON_M] = TWIST_EDIT(fTwistOnM,  "TWIST ON MM",   UI_TWIST_EDIT_OFF_H, NULL),
+    [UI_TWIST_EDIT_OFF_H]= TWIST_EDIT(fTwistOffH, "TWIST OFF HH",  UI_TWIST_EDIT_OFF_M, NULL),
+    [UI_TWIST_EDIT_OFF_M]= TWIST_EDIT(fTwistOffM, "TWIST OFF MM",  UI_DASH, apply_twist),
+
+    /* COUNTDOWN edit keys are special (hold DOWN), drawing is not */
+    [UI_COUNTDOWN_EDIT_MIN] = { .kind = SCR_EDIT, .title = "SET MINUTES", .fmt = VAL_NEXT,
+                                FIELDS(fCountdown), .next = UI_DASH, .back = UI_DASH },
+
+    /* DEVICE SETUP */
+    [UI_DEVSET_MENU]      = { .kind = SCR_LIST, ITEMS(devsetItems),
+                              .idx = &devset_idx, .back = UI_MENU },
+    [UI_SETTINGS_GAP]     = SETTING(fSetGap,     "Set Dry Run",    "val:%2umin Next>", apply_settings_core),
+    [UI_SETTINGS_RETRY]   = SETTING(fSetRetry,   "Testing Gap",    "val:%3umin Next>", apply_settings_core),
+    [UI_SETTINGS_UV]      = SETTING(fSetUv,      "Set Low Volt",   "val:%3uV Next>",   apply_settings_core),
+    [UI_SETTINGS_OV]      = SETTING(fSetOv,      "Set High Volt",  "val:%3uV Next>",   apply_settings_core),
+    [UI_SETTINGS_OL]      = SETTING(fSetOl,      "Over Load (A)",  "val:%3u Next>",    apply_settings_core),
+    [UI_SETTINGS_UL]      = SETTING(fSetUl,      "Under Load (A)", "val:%3u Next>",    apply_settings_core),
+    [UI_SETTINGS_MAXRUN]  = SETTING(fSetMaxrun,  "Set Max Run",    "val:%3umin Next>", apply_settings_core),
+    [UI_SETTINGS_PWRREST] = SETTING(fSetPwr,     "Power Restore",  "%-10sNext>",       apply_pwrrest),
+    [UI_SETTINGS_FACTORY] = SETTING(fSetFactory, "Factory Reset?", "%-10sNext>",       apply_factory),
+    [UI_DEVSET_EDIT_DATE] = SETTING(fDate,       "Set Date",       "-",                apply_date),
+    [UI_DEVSET_EDIT_TIME] = SETTING(fTime,       "Set Time",       ":",                apply_time),
+    [UI_DEVSET_EDIT_DAY]  = SETTING(fDay,        "Set Day",        "> %s",             apply_day),
+
+    /* ADD NEW DEVICE */
+    [UI_ADD_DEVICE_MENU]   = { .kind = SCR_LIST, ITEMS(addDevItems),
+                               .idx = &addDevMenuIndex, .back = UI_MENU },
+    [UI_ADD_DEVICE_PAIR]   = { .kind = SCR_LIST, .title = "Pair Device", ITEMS(pairItems),
+                               .idx = &addDevTypeIndex, .back = UI_ADD_DEVICE_MENU },
+    [UI_ADD_DEVICE_REMOVE] = { .kind = SCR_LIST, .title = "Remove Device", ITEMS(removeItems),
+                               .idx = &addDevTypeIndex, .back = UI_ADD_DEVICE_MENU },
+    [UI_ADD_DEVICE_PAIR_DONE]   = { .kind = SCR_EDIT, .next = UI_ADD_DEVICE_MENU,
+                                    .back = UI_ADD_DEVICE_MENU, .draw = show_add_device_done },
+    [UI_ADD_DEVICE_REMOVE_DONE] = { .kind = SCR_EDIT, .next = UI_ADD_DEVICE_MENU,
+                                    .back = UI_ADD_DEVICE_MENU, .draw = show_add_device_done },
+
+    [UI_RESET_CONFIRM] = { .kind = SCR_EDIT, .title = "Reset To Default?", .fmt = "%s",
+                           FIELDS(fConfirm), .done = apply_reset_confirm,
+                           .next = UI_DASH, .back = UI_MENU },
+};
 
-        default:
-            break;
+/* ================================================================
+   MENU ENGINE
+   ================================================================ */
+static int32_t field_get(const UiField *f)
+{
+    switch (f->type)
+    {
+        case UI_VT_U16:  return *(uint16_t*)f->val;
+        case UI_VT_INT:  return *(int*)f->val;
+        case UI_VT_BOOL: return *(bool*)f->val;
+        default:         return *(uint8_t*)f->val;
     }
+}
 
-    screenNeedsRefresh = true;
+static void field_set(const UiField *f, int32_t v)
+{
+    switch (f->type)
+    {
+        case UI_VT_U16:  *(uint16_t*)f->val = (uint16_t)v; break;
+        case UI_VT_INT:  *(int*)f->val      = (int)v;      break;
+        case UI_VT_BOOL: *(bool*)f->val     = (v != 0);    break;
+        default:         *(uint8_t*)f->val  = (uint8_t)v;  break;
+    }
 }
 
-/* ================================================================
-   VALUE EDIT ENGINE
-   ================================================================ */
-void increase_edit_value(void)
+static void field_step(const UiField *f, bool up)
 {
-    switch(ui)
+    int32_t v    = field_get(f);
+    int32_t step = f->step ? f->step : 1;
+    bool    gap  = (f->flags & UI_VF_OFF_GAP) != 0;
+    bool    wrap = (f->flags & UI_VF_WRAP) != 0;
+
+    if (f->type == UI_VT_BOOL)              // UP = YES, DOWN = NO
+        v = up;
+    else if (up)
     {
-        /* TIMER ON TIME */
-        case UI_TIMER_EDIT_ON_TIME:
-            if (time_edit_field == 0) { if (edit_on_h < 23) edit_on_h++; }
-            else                      { if (edit_on_m < 59) edit_on_m++; }
-            break;
+        if (gap && v == 0)           v = f->min;
+        else if (v + step <= f->max) v += step;
+        else if (wrap)               v = gap ? 0 : f->min;
+    }
+    else
+    {
+        if (gap && v == f->min)      v = 0;
+        else if (v - step >= f->min) v -= step;
+        else if (wrap && v == f->min) v = f->max;
+    }
 
-        /* TIMER OFF TIME */
-        case UI_TIMER_EDIT_OFF_TIME:
-            if (time_edit_field == 0) { if (edit_off_h < 23) edit_off_h++; }
-            else                      { if (edit_off_m < 59) edit_off_m++; }
-            break;
+    field_set(f, v);
+}
 
-        /* TIMER GAP */
-        case UI_TIMER_EDIT_GAP:
-            if (edit_gap_min < 240) edit_gap_min++;  // limit 4 hours
-            break;
+static void ui_goto(UiState next)
+{
+    if (next >= UI_NONE)
+        return;
 
-        /* AUTO SETTINGS */
-        case UI_AUTO_EDIT_GAP:      edit_auto_gap_s++; break;
-        case UI_AUTO_EDIT_MAXRUN:   edit_auto_maxrun_min++; break;
-        case UI_AUTO_EDIT_RETRY:    edit_auto_retry++; break;
-
-        /* TWIST MODE */
-        case UI_TWIST_EDIT_ON:    edit_twist_on_s++; break;
-        case UI_TWIST_EDIT_OFF:   edit_twist_off_s++; break;
-        case UI_TWIST_EDIT_ON_H:  if (edit_twist_on_hh < 23) edit_twist_on_hh++; break;
-        case UI_TWIST_EDIT_ON_M:  if (edit_twist_on_mm < 59) edit_twist_on_mm++; break;
-        case UI_TWIST_EDIT_OFF_H: if (edit_twist_off_hh < 23) edit_twist_off_hh++; break;
-        case UI_TWIST_EDIT_OFF_M: if (edit_twist_off_mm < 59) edit_twist_off_mm++; break;
-
-        /* COUNTDOWN */
-        case UI_COUNTDOWN_EDIT_MIN:
-            if (edit_countdown_min < 999) edit_countdown_min++;
-            break;
+    ui       = next;
+    ui_field = 0;
+    if (s_screens[next].kind == SCR_LIST)
+        ui_top = *s_screens[next].idx;      // picked item on the top row
+    screenNeedsRefresh = true;
+}
 
-        /* SETTINGS / DEVICE SETUP */
-        /* Dry run gap: 0..15 min */
-        case UI_SETTINGS_GAP:
-            if (edit_settings_gap_s < 15) edit_settings_gap_s++;
-            break;
+static void ui_title(char *out, const UiScreen *s)
+{
+    snprintf(out, 17, s->title ? s->title : "", (unsigned)(currentSlot + 1));
+}
 
-        /* Testing Gap: 0..180min */
-        case UI_SETTINGS_RETRY:
-            if (edit_settings_retry < 180) edit_settings_retry++;
-            break;
+static void draw_list(const UiScreen *s)
+{
+    char    l[2][17];
+    uint8_t i = *s->idx;
 
-        /* Low Volt: 0=Disable, else 150..200V */
-        case UI_SETTINGS_UV:
-            if (edit_settings_uv == 0) edit_settings_uv = 150;
-            else if (edit_settings_uv < 200) edit_settings_uv++;
-            break;
+    if (s->title)
+    {
+        /* one item under a title */
+        ui_title(l[0], s);
+        snprintf(l[1], sizeof(l[1]), "> %s", s->items[i].label);
+    }
+    else
+    {
+        /* two-row scroll list */
+        char mark = ((s->flags & SCR_F_BLINK) && !cursorVisible) ? ' ' : '>';
 
-        /* High Volt: 0=Disable, else 250..300V */
-        case UI_SETTINGS_OV:
-            if (edit_settings_ov == 0) edit_settings_ov = 250;
-            else if (edit_settings_ov < 300) edit_settings_ov++;
-            break;
+        if (i < ui_top)          ui_top = i;
+        else if (i > ui_top + 1) ui_top = i - 1;
+
+        for (uint8_t r = 0; r < 2; r++)
+        {
+            uint8_t n = ui_top + r;
+            if (n < s->count)
+                snprintf(l[r], sizeof(l[r]), "%c%-15.15s",
+                         (n == i) ? mark : ' ', s->items[n].label);
+            else
+                l[r][0] = '\0';
+        }
+    }
 
-        /* Over Load: 0..25A (0=Disable) */
-        case UI_SETTINGS_OL:
-        	if (edit_settings_ol < 25) edit_settings_ol++;  // Increment by 1
-        	break;
+    lcd_line0(l[0]);
+    lcd_line1(l[1]);
+}
 
-        case UI_SETTINGS_UL:
-        	if (edit_settings_ul < 10) edit_settings_ul++;  // Increment by 1
-        	break;
+static void draw_edit(const UiScreen *s)
+{
+    char l0[17], l1[17];
 
-        /* Max Run: 0=Disable, else 10..300min */
-        case UI_SETTINGS_MAXRUN:
-            if (edit_settings_maxrun == 0) edit_settings_maxrun = 10;
-            else if (edit_settings_maxrun < 300) edit_settings_maxrun++;
-            break;
+    ui_title(l0, s);
 
-        /* Power Restore: 0=YES,1=NO,2=LAST */
-        case UI_SETTINGS_PWRREST:
-            if (edit_settings_pwrrest < 2) edit_settings_pwrrest++;
-            else edit_settings_pwrrest = 0;
-            break;
+    if (s->count > 1)
+    {
+        /* [HH]:MM style: brackets mark the field being edited */
+        int n = 0;
+        for (uint8_t k = 0; k < s->count && n < (int)sizeof(l1) - 1; k++)
+        {
+            int32_t v = field_get(&s->fields[k]);
+            if (s->fields[k].flags & UI_VF_YY)
+                v %= 100;
+            if (k)
+                l1[n++] = s->fmt[0];
+            n += snprintf(l1 + n, sizeof(l1) - n,
+                          (k == ui_field) ? "[%02u]" : "%02u", (unsigned)v);
+        }
+        if (n < (int)sizeof(l1))
+            snprintf(l1 + n, sizeof(l1) - n, "%s", s->fmt + 1);
+    }
+    else if (s->count == 1)
+    {
+        const UiField *f = s->fields;
+        int32_t        v = field_get(f);
+
+        if (f->names)
+            snprintf(l1, sizeof(l1), s->fmt, f->names[v]);
+        else if ((f->flags & UI_VF_DISABLE) && v == 0)
+            snprintf(l1, sizeof(l1), "Disable    Next>");
+        else
+            snprintf(l1, sizeof(l1), s->fmt, (unsigned)v);
+    }
+    else
+    {
+        snprintf(l1, sizeof(l1), "%s", s->fmt ? s->fmt : "");
+    }
 
-        case UI_SETTINGS_FACTORY:
-            edit_settings_factory_yes ^= 1;
-            break;
+    lcd_line0(l0);
+    lcd_line1(l1);
+}
 
-        /* DEVSET DATE/TIME/DAY */
-        case UI_DEVSET_EDIT_DATE:
-            if (edit_date_field == 0) {
-                if (edit_date_dd < 31) edit_date_dd++;
-            } else if (edit_date_field == 1) {
-                if (edit_date_mm < 12) edit_date_mm++;
-            } else {
-                if (edit_date_yyyy < 2099) edit_date_yyyy++;
-            }
-            break;
+static void ui_draw(void)
+{
+    const UiScreen *s = &s_screens[ui];
 
-        case UI_DEVSET_EDIT_TIME:
-            if (edit_time_field == 0) {
-                if (edit_time_hh < 23) edit_time_hh++;
-            } else {
-                if (edit_time_min < 59) edit_time_min++;
-            }
-            break;
+    if (s->draw)                 s->draw();
+    else if (s->kind == SCR_LIST) draw_list(s);
+    else if (s->kind == SCR_EDIT) draw_edit(s);
+}
 
-        case UI_DEVSET_EDIT_DAY:
-            edit_day_idx2 = (uint8_t)((edit_day_idx2 + 1) % 7);
-            break;
+/* UP = previous item / larger value */
+static void ui_move(const UiScreen *s, bool up)
+{
+    if (s->kind == SCR_LIST)
+    {
+        uint8_t *i    = s->idx;
+        bool     wrap = (s->flags & SCR_F_WRAP) != 0;
 
-        default:
-            break;
+        if (up)
+        {
+            if (*i > 0)    (*i)--;
+            else if (wrap) *i = s->count - 1;
+        }
+        else
+        {
+            if (*i + 1 < s->count) (*i)++;
+            else if (wrap)         *i = 0;
+        }
     }
+    else if (s->kind == SCR_EDIT && ui_field < s->count)
+    {
+        field_step(&s->fields[ui_field], up);
+    }
+
+    screenNeedsRefresh = true;
 }
 
-void decrease_edit_value(void)
+static void ui_select(const UiScreen *s)
 {
-    switch(ui)
+    if (s->kind == SCR_LIST)
     {
-        /* TIMER ON TIME */
-        case UI_TIMER_EDIT_ON_TIME:
-            if (time_edit_field == 0) { if (edit_on_h > 0) edit_on_h--; }
-            else                      { if (edit_on_m > 0) edit_on_m--; }
-            break;
-
-        /* TIMER OFF TIME */
-        case UI_TIMER_EDIT_OFF_TIME:
-            if (time_edit_field == 0) { if (edit_off_h > 0) edit_off_h--; }
-            else                      { if (edit_off_m > 0) edit_off_m--; }
-            break;
+        uint8_t       i  = *s->idx;
+        const UiItem *it = &s->items[i];
 
-        /* TIMER GAP */
-        case UI_TIMER_EDIT_GAP:
-            if (edit_gap_min > 0) edit_gap_min--;
-            break;
+        if (it->hook)
+            it->hook(i);
+        ui_goto(it->target);                // UI_NONE: stay
+    }
+    else if (ui_field + 1 < s->count)
+    {
+        ui_field++;
+    }
+    else
+    {
+        UiState to = s->done ? s->done() : UI_NONE;
+        ui_goto(to != UI_NONE ? to : s->next);
+    }
 
-        /* AUTO SETTINGS */
-        case UI_AUTO_EDIT_GAP:      if(edit_auto_gap_s > 0) edit_auto_gap_s--; break;
-        case UI_AUTO_EDIT_MAXRUN:   if(edit_auto_maxrun_min > 0) edit_auto_maxrun_min--; break;
-        case UI_AUTO_EDIT_RETRY:    if(edit_auto_retry > 0) edit_auto_retry--; break;
-
-        /* TWIST */
-        case UI_TWIST_EDIT_ON:      if(edit_twist_on_s > 0) edit_twist_on_s--; break;
-        case UI_TWIST_EDIT_OFF:     if(edit_twist_off_s > 0) edit_twist_off_s--; break;
-        case UI_TWIST_EDIT_ON_H:    if(edit_twist_on_hh > 0) edit_twist_on_hh--; break;
-        case UI_TWIST_EDIT_ON_M:    if(edit_twist_on_mm > 0) edit_twist_on_mm--; break;
-        case UI_TWIST_EDIT_OFF_H:   if(edit_twist_off_hh > 0) edit_twist_off_hh--; break;
-        case UI_TWIST_EDIT_OFF_M:   if(edit_twist_off_mm > 0) edit_twist_off_mm--; break;
-
-        /* COUNTDOWN */
-        case UI_COUNTDOWN_EDIT_MIN:
-            if (edit_countdown_min > 1) edit_countdown_min--;
-            break;
+    screenNeedsRefresh = true;
+}
 
-        /* SETTINGS / DEVICE SETUP */
-        /* Dry run gap: 0..15, 0=Disable */
-        case UI_SETTINGS_GAP:
-            if(edit_settings_gap_s > 0) edit_settings_gap_s--;
+static void ui_key(const UiScreen *s, UiButton b)
+{
+    switch (b)
+    {
+        case BTN_UP_LONG:
+        case BTN_DOWN_LONG:
+            last_repeat_time = HAL_GetTick();
+            ui_move(s, b == BTN_UP_LONG);
             break;
 
-        /* Testing Gap: 0..180 */
-        case UI_SETTINGS_RETRY:
-            if(edit_settings_retry > 0) edit_settings_retry--;
+        case BTN_UP:
+        case BTN_DOWN:
+            ui_move(s, b == BTN_UP);
             break;
 
-        /* Low Volt: 0=Disable, else down to 150 */
-        case UI_SETTINGS_UV:
-            if (edit_settings_uv > 150) edit_settings_uv--;
-            else if (edit_settings_uv == 150) edit_settings_uv = 0;
+        case BTN_SELECT_LONG:
+            if (s->kind == SCR_LIST)
+                ui_select(s);
             break;
 
-        /* High Volt: 0=Disable, else down to 250 */
-        case UI_SETTINGS_OV:
-            if (edit_settings_ov > 250) edit_settings_ov--;
-            else if (edit_settings_ov == 250) edit_settings_ov = 0;
+        case BTN_SELECT:
+            ui_select(s);
             break;
 
-        case UI_SETTINGS_OL:
-        	if (edit_settings_ol > 0) edit_settings_ol--;  // Decrement by 1
-        	break;
-        case UI_SETTINGS_UL:
-        	if (edit_settings_ul > 0) edit_settings_ul--;  // Decrement by 1
-        	break;
-
-        /* Max Run: 0=Disable, else 10..300 */
-        case UI_SETTINGS_MAXRUN:
-            if(edit_settings_maxrun > 10) edit_settings_maxrun--;
-            else if (edit_settings_maxrun == 10) edit_settings_maxrun = 0;
+        case BTN_RESET:
+            ui_goto(s->back);
             break;
 
-        /* Power Restore: 0=YES,1=NO,2=LAST */
-        case UI_SETTINGS_PWRREST:
-            if (edit_settings_pwrrest == 0) edit_settings_pwrrest = 2;
-            else edit_settings_pwrrest--;
+        default:
             break;
+    }
+}
 
-        case UI_SETTINGS_FACTORY:
-            edit_settings_factory_yes ^= 1;
+static void meter_key(UiButton b)
+{
+    switch (b)
+    {
+        case BTN_UP:
+            meter_page = (meter_page + METER_PAGE_COUNT - 1) % METER_PAGE_COUNT;
             break;
 
-        /* DEVSET DATE/TIME/DAY */
-        case UI_DEVSET_EDIT_DATE:
-            if (edit_date_field == 0) {
-                if (edit_date_dd > 1) edit_date_dd--;
-            } else if (edit_date_field == 1) {
-                if (edit_date_mm > 1) edit_date_mm--;
-            } else {
-                if (edit_date_yyyy > 2020) edit_date_yyyy--;
-            }
+        case BTN_DOWN:
+            meter_page = (meter_page + 1) % METER_PAGE_COUNT;
             break;
 
-        case UI_DEVSET_EDIT_TIME:
-            if (edit_time_field == 0) {
-                if (edit_time_hh > 0) edit_time_hh--;
-            } else {
-                if (edit_time_min > 0) edit_time_min--;
-            }
+        case BTN_SELECT:
+            ui_goto(UI_DASH);
             break;
 
-        case UI_DEVSET_EDIT_DAY:
-            edit_day_idx2 = (uint8_t)((edit_day_idx2 + 6) % 7);
+        case BTN_RESET:
+            ui_goto(UI_MENU);
             break;
 
         default:
             break;
     }
+
+    screenNeedsRefresh = true;
 }
 
 /***************************************************************
@@ -1437,9 +1348,6 @@ static UiButton decode_button_press(void)
     return out;
 }
 
-/***************************************************************
- *  MAIN SWITCH HANDLER
- ***************************************************************/
 /***************************************************************
  *  MAIN SWITCH HANDLER
  ***************************************************************/
@@ -1450,6 +1358,8 @@ void Screen_HandleSwitches(void)
     UiButton b = decode_button_press();
     uint32_t now = HAL_GetTick();
 
+    const UiScreen *s = &s_screens[ui];
+
     bool sw_up   = Switch_IsPressed(2);
     bool sw_down = Switch_IsPressed(3);
 
@@ -1457,71 +1367,17 @@ void Screen_HandleSwitches(void)
     if (b == BTN_RESET_LONG)
     {
         ModelHandle_ToggleManual();
-        ui = UI_DASH;
-        screenNeedsRefresh = true;
+        ui_goto(UI_DASH);
         return;
     }
 
-    /* CONTINUOUS UP (HOLD) */
-    if (sw_up && sw_long_issued[2] && ui != UI_COUNTDOWN_EDIT_MIN)
-    {
-        if (now - last_repeat_time >= CONTINUOUS_STEP_MS)
-        {
-            last_repeat_time = now;
-
-            if (ui == UI_MENU)
-            {
-                if (menu_idx > 0) menu_idx--;
-            }
-            else if (ui == UI_TIMER_SLOT_SELECT)
-            {
-                if (currentSlot > 0) currentSlot--;
-                timer_page = (currentSlot < 2 ? 0 :
-                             (currentSlot < 5 ? 1 : 2));
-            }
-            else if (ui == UI_DEVSET_MENU)
-            {
-                if (devset_idx > 0) devset_idx--;
-            }
-            else
-            {
-                /* Any edit screen (excluding countdown edit) */
-                increase_edit_value();
-            }
-
-            screenNeedsRefresh = true;
-        }
-    }
-
-    /* CONTINUOUS DOWN (HOLD) */
-    if (sw_down && sw_long_issued[3] && ui != UI_COUNTDOWN_EDIT_MIN)
+    /* CONTINUOUS UP / DOWN (HOLD) on any list or editor */
+    if (s->kind != SCR_VIEW && ui != UI_COUNTDOWN_EDIT_MIN &&
+        ((sw_up && sw_long_issued[2]) || (sw_down && sw_long_issued[3])) &&
+        now - last_repeat_time >= CONTINUOUS_STEP_MS)
     {
-        if (now - last_repeat_time >= CONTINUOUS_STEP_MS)
-        {
-            last_repeat_time = now;
-
-            if (ui == UI_MENU)
-            {
-                if (menu_idx < MAIN_MENU_COUNT - 1) menu_idx++;
-            }
-            else if (ui == UI_TIMER_SLOT_SELECT)
-            {
-                if (currentSlot < 5) currentSlot++;
-                timer_page = (currentSlot < 2 ? 0 :
-                             (currentSlot < 5 ? 1 : 2));
-            }
-            else if (ui == UI_DEVSET_MENU)
-            {
-                if (devset_idx < DEVSET_MENU_COUNT - 1) devset_idx++;
-            }
-            else
-            {
-                /* Any edit screen (excluding countdown edit) */
-                decrease_edit_value();
-            }
-
-            screenNeedsRefresh = true;
-        }
+        last_repeat_time = now;
+        ui_move(s, sw_up);
     }
 
     /* ============================================
@@ -1534,566 +1390,38 @@ void Screen_HandleSwitches(void)
     {
         if (sw_down)
         {
-            /* first press → immediate step + start repeat timer */
-            if (!prev_sw_down_edit)
+            /* first press → immediate step, then repeat while held */
+            if (!prev_sw_down_edit ||
+                now - last_repeat_time >= CONTINUOUS_STEP_MS)
             {
                 last_repeat_time = now;
-                increase_edit_value();
-                screenNeedsRefresh = true;
-            }
-            else if (now - last_repeat_time >= CONTINUOUS_STEP_MS)
-            {
-                /* continuous increase while holding */
-                last_repeat_time = now;
-                increase_edit_value();
-                screenNeedsRefresh = true;
+                ui_move(s, true);
             }
         }
 
         /* detect release → leave edit mode */
         if (!sw_down && prev_sw_down_edit)
-        {
-            ui = UI_DASH;
-            screenNeedsRefresh = true;
-        }
+            ui_goto(UI_DASH);
 
         prev_sw_down_edit = sw_down;
         return;
     }
-    else
-    {
-        /* not in countdown edit → reset tracking flag */
-        prev_sw_down_edit = false;
-    }
+
+    /* not in countdown edit → reset tracking flag */
+    prev_sw_down_edit = false;
 
     if (b == BTN_NONE) return;
     refreshInactivityTimer();
 
-    /* ================================
-       GENERIC EDITING MODES
-       ================================ */
-    bool editing =
-        (ui == UI_TIMER_EDIT_ON_TIME ||
-         ui == UI_TIMER_EDIT_OFF_TIME ||
-         ui == UI_TIMER_EDIT_GAP ||
-         ui == UI_AUTO_EDIT_GAP ||
-         ui == UI_AUTO_EDIT_MAXRUN ||
-         ui == UI_AUTO_EDIT_RETRY ||
-         ui == UI_TWIST_EDIT_ON ||
-         ui == UI_TWIST_EDIT_OFF ||
-         ui == UI_TWIST_EDIT_ON_H ||
-         ui == UI_TWIST_EDIT_ON_M ||
-         ui == UI_TWIST_EDIT_OFF_H ||
-         ui == UI_TWIST_EDIT_OFF_M ||
-         /* NOTE: UI_COUNTDOWN_EDIT_MIN is handled separately above */
-         (ui >= UI_SETTINGS_GAP && ui <= UI_SETTINGS_FACTORY) ||
-         ui == UI_DEVSET_EDIT_DATE ||
-         ui == UI_DEVSET_EDIT_TIME ||
-         ui == UI_DEVSET_EDIT_DAY);
-
-    if (editing)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-                increase_edit_value();
-                break;
-
-            case BTN_DOWN:
-                decrease_edit_value();
-                break;
-
-            case BTN_UP_LONG:
-                last_repeat_time = now;
-                increase_edit_value();
-                break;
-
-            case BTN_DOWN_LONG:
-                last_repeat_time = now;
-                decrease_edit_value();
-                break;
-
-            case BTN_SELECT:
-
-                /* TIMER editing uses linear flow via menu_select() */
-                if (ui == UI_TIMER_EDIT_ON_TIME ||
-                    ui == UI_TIMER_EDIT_OFF_TIME ||
-                    ui == UI_TIMER_EDIT_GAP)
-                {
-                    menu_select();
-                }
-                /* SETTINGS from Device Setup: apply and go back to DEVSET menu */
-                else if (ui >= UI_SETTINGS_GAP && ui <= UI_SETTINGS_MAXRUN)
-                {
-                    apply_settings_core();
-                    ui = UI_DEVSET_MENU;
-                }
-                else if (ui == UI_SETTINGS_PWRREST)
-                {
-                    ModelHandle_SetPowerRestoreMode(edit_settings_pwrrest);
-                    ui = UI_DEVSET_MENU;
-                }
-                else if (ui == UI_SETTINGS_FACTORY)
-                {
-                    if (edit_settings_factory_yes)
-                        ModelHandle_FactoryReset();
-                    ui = UI_DEVSET_MENU;
-                }
-                /* Device setup: Set Date */
-                else if (ui == UI_DEVSET_EDIT_DATE)
-                {
-                    if (edit_date_field < 2)
-                    {
-                        edit_date_field++;  // DD -> MM -> YY
-                    }
-                    else
-                    {
-                        /* Finished editing → write to RTC */
-                        RTC_GetTimeDate();
-
-                        uint8_t sec   = time.sec;
-                        uint8_t min   = time.min;
-                        uint8_t hour  = time.hour;
-                        uint8_t dow   = time.dow;
-                        uint8_t dom   = edit_date_dd;
-                        uint8_t month = edit_date_mm;
-                        uint16_t year = edit_date_yyyy;
-
-                        RTC_SetTimeDate(sec, min, hour, dow, dom, month, year);
-                        RTC_GetTimeDate();
-
-                        edit_date_field = 0;
-                        ui = UI_DEVSET_MENU;
-                    }
-                }
-                /* Device setup: Set Time */
-                else if (ui == UI_DEVSET_EDIT_TIME)
-                {
-                    if (edit_time_field == 0)
-                    {
-                        edit_time_field = 1;   // HH -> MM
-                    }
-                    else
-                    {
-                        RTC_GetTimeDate();
-
-                        uint8_t sec   = time.sec;
-                        uint8_t dow   = time.dow;
-                        uint8_t dom   = time.dom;
-                        uint8_t month = time.month;
-                        uint16_t year = time.year;
-
-                        RTC_SetTimeDate(sec,
-                                        edit_time_min,
-                                        edit_time_hh,
-                                        dow, dom, month, year);
-
-                        RTC_GetTimeDate();
-
-                        edit_time_field = 0;
-                        ui = UI_DEVSET_MENU;
-                    }
-                }
-                /* Device setup: Set Day */
-                else if (ui == UI_DEVSET_EDIT_DAY)
-                {
-                    RTC_GetTimeDate();
-
-                    uint8_t sec   = time.sec;
-                    uint8_t min   = time.min;
-                    uint8_t hour  = time.hour;
-                    uint8_t dom   = time.dom;
-                    uint8_t month = time.month;
-                    uint16_t year = time.year;
-
-                    /* DS1307 DOW 1..7 */
-                    uint8_t dow   = (uint8_t)((edit_day_idx2 % 7) + 1);
-
-                    RTC_SetTimeDate(sec, min, hour, dow, dom, month, year);
-                    RTC_GetTimeDate();
-
-                    ui = UI_DEVSET_MENU;
-                }
-                else
-                {
-                    /* Fallback: just go back to Device Setup menu */
-                    ui = UI_DEVSET_MENU;
-                }
-                break;
-
-            case BTN_RESET:
-                if (ui >= UI_SETTINGS_GAP && ui <= UI_SETTINGS_FACTORY)
-                {
-                    ui = UI_DEVSET_MENU;
-                }
-                else if (ui == UI_DEVSET_EDIT_DATE ||
-                         ui == UI_DEVSET_EDIT_TIME ||
-                         ui == UI_DEVSET_EDIT_DAY)
-                {
-                    ui = UI_DEVSET_MENU;
-                }
-                else
-                {
-                    ui = UI_MENU;
-                }
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ===============================
-       TIMER DAYS SELECTION
-       =============================== */
-    if (ui == UI_TIMER_EDIT_DAYS)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-            case BTN_UP_LONG:
-                if (edit_day_index == 0) edit_day_index = 9;
-                else edit_day_index--;
-                break;
-
-            case BTN_DOWN:
-            case BTN_DOWN_LONG:
-                edit_day_index = (edit_day_index + 1) % 10;
-                break;
-
-            case BTN_SELECT:
-                if (edit_day_index < 7)
-                    edit_day_mask ^= (1u << edit_day_index);
-                else if (edit_day_index == 7)
-                    edit_day_mask = 0x7F;
-                else if (edit_day_index == 8)
-                    edit_day_mask = 0x00;
-                else if (edit_day_index == 9)
-                    ui = UI_TIMER_EDIT_GAP;
-                break;
-
-            case BTN_RESET:
-                ui = UI_TIMER_SLOT_SELECT;
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ===============================
-       TIMER ENABLE / DISABLE
-       =============================== */
-    if (ui == UI_TIMER_EDIT_ENABLE)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-            case BTN_UP_LONG:
-                edit_slot_enabled = true;
-                break;
-
-            case BTN_DOWN:
-            case BTN_DOWN_LONG:
-                edit_slot_enabled = false;
-                break;
-
-            case BTN_SELECT:
-                ui = UI_TIMER_EDIT_SUMMARY;
-                break;
-
-            case BTN_RESET:
-                ui = UI_TIMER_SLOT_SELECT;
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ===============================
-       ADD NEW DEVICE — MAIN MENU
-       =============================== */
-    if (ui == UI_ADD_DEVICE_MENU)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-            case BTN_UP_LONG:
-                if (addDevMenuIndex > 0) addDevMenuIndex--;
-                break;
-
-            case BTN_DOWN:
-            case BTN_DOWN_LONG:
-                if (addDevMenuIndex < 1) addDevMenuIndex++;
-                break;
-
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-                addDevTypeIndex = 0;
-                if (addDevMenuIndex == 0)
-                    ui = UI_ADD_DEVICE_PAIR;
-                else
-                    ui = UI_ADD_DEVICE_REMOVE;
-                break;
-
-            case BTN_RESET:
-                ui = UI_MENU;
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ADD NEW DEVICE — PAIR */
-    if (ui == UI_ADD_DEVICE_PAIR)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-            case BTN_UP_LONG:
-                if (addDevTypeIndex > 0) addDevTypeIndex--;
-                break;
-
-            case BTN_DOWN:
-            case BTN_DOWN_LONG:
-                if (addDevTypeIndex < 2) addDevTypeIndex++;
-                break;
-
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-                lastAddActionPair = true;
-                lastAddDevType = addDevTypeIndex;
-                ui = UI_ADD_DEVICE_PAIR_DONE;
-                break;
-
-            case BTN_RESET:
-                ui = UI_ADD_DEVICE_MENU;
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ADD NEW DEVICE — REMOVE */
-    if (ui == UI_ADD_DEVICE_REMOVE)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-            case BTN_UP_LONG:
-                if (addDevTypeIndex > 0) addDevTypeIndex--;
-                break;
-
-            case BTN_DOWN:
-            case BTN_DOWN_LONG:
-                if (addDevTypeIndex < 2) addDevTypeIndex++;
-                break;
-
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-                lastAddActionPair = false;
-                lastAddDevType = addDevTypeIndex;
-                ui = UI_ADD_DEVICE_REMOVE_DONE;
-                break;
-
-            case BTN_RESET:
-                ui = UI_ADD_DEVICE_MENU;
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ADD NEW DEVICE — DONE SCREENS */
-    if (ui == UI_ADD_DEVICE_PAIR_DONE || ui == UI_ADD_DEVICE_REMOVE_DONE)
-    {
-        switch (b)
-        {
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-            case BTN_RESET:
-                ui = UI_ADD_DEVICE_MENU;
-                break;
-            default:
-                break;
-        }
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ===============================
-       RESET TO DEFAULT CONFIRM
-       =============================== */
-    if (ui == UI_RESET_CONFIRM)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-            case BTN_UP_LONG:
-                reset_confirm_yes = true;
-                break;
-
-            case BTN_DOWN:
-            case BTN_DOWN_LONG:
-                reset_confirm_yes = false;
-                break;
-
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-                if (reset_confirm_yes)
-                {
-                    ModelHandle_FactoryReset();
-                }
-                ui = UI_DASH;
-                break;
-
-            case BTN_RESET:
-                ui = UI_MENU;
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ===============================
-       DEVICE SETUP MENU (scroll)
-       =============================== */
-    if (ui == UI_DEVSET_MENU)
+    /* lists, editors and views with their own keys */
+    if (s->kind != SCR_VIEW)
     {
-        switch (b)
-        {
-            case BTN_UP:
-            case BTN_UP_LONG:
-                if (devset_idx > 0) devset_idx--;
-                break;
-
-            case BTN_DOWN:
-            case BTN_DOWN_LONG:
-                if (devset_idx < DEVSET_MENU_COUNT - 1) devset_idx++;
-                break;
-
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-                switch (devset_idx)
-                {
-                    case 0:  ui = UI_SETTINGS_GAP;        break;
-                    case 1:  ui = UI_SETTINGS_RETRY;      break;
-                    case 2:  ui = UI_SETTINGS_UV;         break;
-                    case 3:  ui = UI_SETTINGS_OV;         break;
-                    case 4:  ui = UI_SETTINGS_OL;         break;
-                    case 5:  ui = UI_SETTINGS_UL;         break;
-                    case 6:  ui = UI_SETTINGS_MAXRUN;     break;
-                    case 7:  ui = UI_DEVSET_EDIT_DATE;    break;
-                    case 8:  ui = UI_DEVSET_EDIT_TIME;    break;
-                    case 9:  ui = UI_DEVSET_EDIT_DAY;     break;
-                    case 10: ui = UI_SETTINGS_PWRREST;    break;
-                    case 11: ui = UI_SETTINGS_FACTORY;    break;
-                    case 12: ui = UI_MENU;                break;
-                    default: break;
-                }
-                break;
-
-            case BTN_RESET:
-                ui = UI_MENU;
-                break;
-
-            default:
-                break;
-        }
-
-        screenNeedsRefresh = true;
+        ui_key(s, b);
         return;
     }
-
-    /* ===============================
-       MAIN MENU
-       =============================== */
-    if (ui == UI_MENU)
-    {
-        switch (b)
-        {
-            case BTN_UP:
-                if (menu_idx > 0) menu_idx--;
-                break;
-
-            case BTN_DOWN:
-                if (menu_idx < MAIN_MENU_COUNT - 1) menu_idx++;
-                break;
-
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-                menu_select();
-                break;
-
-            case BTN_RESET:
-                ui = UI_DASH;
-                break;
-
-            default:
-                break;
-        }
-        screenNeedsRefresh = true;
-        return;
-    }
-
-    /* ===============================
-       TIMER SLOT SELECT
-       =============================== */
-    if (ui == UI_TIMER_SLOT_SELECT)
+    if (s->key)
     {
-        switch (b)
-        {
-            case BTN_UP:
-                if (currentSlot > 0) currentSlot--;
-                break;
-
-            case BTN_DOWN:
-                if (currentSlot < 5) currentSlot++;
-                break;
-
-            case BTN_SELECT:
-            case BTN_SELECT_LONG:
-                menu_select();
-                break;
-
-            case BTN_RESET:
-                ui = UI_MENU;
-                break;
-
-            default:
-                break;
-        }
-
-        timer_page = (currentSlot < 2 ? 0 :
-                     (currentSlot < 5 ? 1 : 2));
-
-        screenNeedsRefresh = true;
+        s->key(b);
         return;
     }
 
@@ -2105,8 +1433,7 @@ void Screen_HandleSwitches(void)
         case BTN_RESET:
             /* Restart pump / test-run */
             reset();
-            ui = UI_DASH;
-            screenNeedsRefresh = true;
+            ui_goto(UI_DASH);
             return;
 
         case BTN_SELECT:
@@ -2121,10 +1448,8 @@ void Screen_HandleSwitches(void)
 
         case BTN_SELECT_LONG:
             /* Open Main Menu */
-            ui = UI_MENU;
             menu_idx = 0;
-            menu_view_top = 0;
-            screenNeedsRefresh = true;
+            ui_goto(UI_MENU);
             return;
 
         case BTN_UP:
@@ -2133,8 +1458,7 @@ void Screen_HandleSwitches(void)
                 ModelHandle_StartTimerNearestSlot();
             else
                 ModelHandle_StopTimer();
-            ui = UI_DASH;
-            screenNeedsRefresh = true;
+            ui_goto(UI_DASH);
             return;
 
         case BTN_UP_LONG:
@@ -2143,8 +1467,7 @@ void Screen_HandleSwitches(void)
                 ModelHandle_StartSemiAuto();
             else
                 ModelHandle_StopSemiAuto();
-            ui = UI_DASH;
-            screenNeedsRefresh = true;
+            ui_goto(UI_DASH);
             return;
 
         case BTN_DOWN:
@@ -2152,23 +1475,19 @@ void Screen_HandleSwitches(void)
             if (!countdownActive)
             {
                 ModelHandle_StartCountdown(edit_countdown_min * 60);
-                ui = UI_COUNTDOWN;
+                ui_goto(UI_COUNTDOWN);
             }
             else
             {
                 ModelHandle_StopCountdown();
-                ui = UI_DASH;
+                ui_goto(UI_DASH);
             }
-            screenNeedsRefresh = true;
             return;
 
         case BTN_DOWN_LONG:
             /* Long press to EDIT countdown time (when not running) */
             if (!countdownActive)
-            {
-                ui = UI_COUNTDOWN_EDIT_MIN;
-                screenNeedsRefresh = true;
-            }
+                ui_goto(UI_COUNTDOWN_EDIT_MIN);
             return;
 
         default:
@@ -2183,35 +1502,33 @@ void Screen_Update(void)
 {
     uint32_t now = HAL_GetTick();
 
-    /* CURSOR BLINK ONLY IN MAIN MENU */
-    bool cursorBlinkActive = (ui == UI_MENU);
-
-    if (cursorBlinkActive && (now - lastCursorToggle >= CURSOR_BLINK_MS))
+    /* CURSOR BLINK (main menu) */
+    if ((s_screens[ui].flags & SCR_F_BLINK) &&
+        now - lastCursorToggle >= CURSOR_BLINK_MS)
     {
         cursorVisible = !cursorVisible;
         lastCursorToggle = now;
-        draw_menu_cursor();
+        screenNeedsRefresh = true;
     }
 
     /* WELCOME → DASH AUTO */
     if (ui == UI_WELCOME && now - lastLcdUpdateTime >= WELCOME_MS)
     {
-        ui = UI_DASH;
         lastLcdUpdateTime = now;
-        screenNeedsRefresh = true;
+        ui_goto(UI_DASH);
     }
 
     /* AUTO BACK TO DASH AFTER INACTIVITY */
     if (ui != UI_WELCOME &&
         ui != UI_DASH &&
+        ui != UI_METER &&
         (now - lastUserAction >= AUTO_BACK_MS))
     {
-        ui = UI_DASH;
-        screenNeedsRefresh = true;
+        ui_goto(UI_DASH);
     }
 
-    /* DASH & COUNTDOWN REFRESH EVERY 1s */
-    if ((ui == UI_DASH || ui == UI_COUNTDOWN) &&
+    /* DASH, COUNTDOWN & METER REFRESH EVERY 1s */
+    if ((ui == UI_DASH || ui == UI_COUNTDOWN || ui == UI_METER) &&
         now - lastLcdUpdateTime >= 1000)
     {
         lastLcdUpdateTime = now;
@@ -2221,84 +1538,16 @@ void Screen_Update(void)
     /* REDRAW IF NEEDED */
     if (screenNeedsRefresh || ui != last_ui)
     {
-        bool fullRefresh = (ui != last_ui);
+        if (ui != last_ui)
+            lcd_fb_clear();
+
         last_ui = ui;
         screenNeedsRefresh = false;
-
-        if (fullRefresh)
-            lcd_clear();
-
-        switch(ui)
-        {
-            /* WELCOME + DASH */
-            case UI_WELCOME:              show_welcome();              break;
-            case UI_DASH:                 show_dash();                 break;
-
-            /* MAIN MENU */
-            case UI_MENU:                 show_menu();                 break;
-
-            /* TIMER */
-            case UI_TIMER_SLOT_SELECT:    show_timer_slot_select();    break;
-            case UI_TIMER_EDIT_ON_TIME:   show_edit_on_time();         break;
-            case UI_TIMER_EDIT_OFF_TIME:  show_edit_off_time();        break;
-            case UI_TIMER_EDIT_DAYS:      show_timer_days();           break;
-            case UI_TIMER_EDIT_GAP:       show_timer_gap();            break;
-            case UI_TIMER_EDIT_ENABLE:    show_timer_enable();         break;
-            case UI_TIMER_EDIT_SUMMARY:   show_timer_summary();        break;
-
-            /* AUTO */
-            case UI_AUTO_MENU:            show_auto_menu();            break;
-            case UI_AUTO_EDIT_GAP:        show_auto_gap();             break;
-            case UI_AUTO_EDIT_MAXRUN:     show_auto_maxrun();          break;
-            case UI_AUTO_EDIT_RETRY:      show_auto_retry();           break;
-
-            /* SEMI AUTO */
-            case UI_SEMI_AUTO:            show_semi_auto();            break;
-
-            /* TWIST */
-            case UI_TWIST:                show_twist();                break;
-            case UI_TWIST_EDIT_ON:        show_twist_on_sec();         break;
-            case UI_TWIST_EDIT_OFF:       show_twist_off_sec();        break;
-            case UI_TWIST_EDIT_ON_H:      show_twist_on_h();           break;
-            case UI_TWIST_EDIT_ON_M:      show_twist_on_m();           break;
-            case UI_TWIST_EDIT_OFF_H:     show_twist_off_h();          break;
-            case UI_TWIST_EDIT_OFF_M:     show_twist_off_m();          break;
-
-            /* COUNTDOWN */
-            case UI_COUNTDOWN:            show_countdown();            break;
-            case UI_COUNTDOWN_EDIT_MIN:   show_countdown_edit_min();   break;
-
-            /* DEVICE SETUP (SCROLL MENU + EDITORS) */
-            case UI_DEVSET_MENU:          show_devset_menu();          break;
-
-            case UI_SETTINGS_GAP:         show_settings_gap();         break;
-            case UI_SETTINGS_RETRY:       show_settings_retry();       break;
-            case UI_SETTINGS_UV:          show_settings_uv();          break;
-            case UI_SETTINGS_OV:          show_settings_ov();          break;
-            case UI_SETTINGS_OL:          show_settings_ol();          break;
-            case UI_SETTINGS_UL:          show_settings_ul();          break;
-            case UI_SETTINGS_MAXRUN:      show_settings_maxrun();      break;
-            case UI_SETTINGS_PWRREST:     show_settings_pwrrest();     break;
-            case UI_SETTINGS_FACTORY:     show_settings_factory();     break;
-
-            case UI_DEVSET_EDIT_DATE:     show_devset_edit_date();     break;
-            case UI_DEVSET_EDIT_TIME:     show_devset_edit_time();     break;
-            case UI_DEVSET_EDIT_DAY:      show_devset_edit_day();      break;
-
-            /* ADD NEW DEVICE FLOWS */
-            case UI_ADD_DEVICE_MENU:        show_add_device_menu();        break;
-            case UI_ADD_DEVICE_PAIR:        show_add_device_pair();        break;
-            case UI_ADD_DEVICE_REMOVE:      show_add_device_remove();      break;
-            case UI_ADD_DEVICE_PAIR_DONE:   show_add_device_pair_done();   break;
-            case UI_ADD_DEVICE_REMOVE_DONE: show_add_device_remove_done(); break;
-
-            /* RESET CONFIRM */
-            case UI_RESET_CONFIRM:        show_reset_confirm();        break;
-
-            default:
-                break;
-        }
+        ui_draw();
     }
+
+    /* only cells that differ from the glass go over I2C */
+    lcd_fb_flush();
 }
 
 /***************************************************************
@@ -0,0 +1,54 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  SIGNAL PATH BENCHMARK – the two kernels @PROF:BENCH# times
+ *
+ *  Kept out of acs712.c so the host harness can build the same
+ *  code. Results go to volatile sinks: only the cost matters,
+ *  and the compiler must not drop the work.
+ ***************************************************************/
+
+#include "sigbench.h"
+#include "acs712.h"
+#include "fixmath.h"
+#include <math.h>
+
+static volatile float    s_sinkF;
+static volatile uint32_t s_sinkU;
+
+void SigBench_Float(const AdcScanFrame *p, uint16_t n)
+{
+    float sum_v = 0.0f, sq_v = 0.0f, sq_i = 0.0f, vi = 0.0f, ema = 0.0f;
+
+    for (uint16_t k = 0; k < n; k++, p++)
+    {
+        float v = ((float)p->v * ADC_VREF) / ADC_RES;
+        float i = ((float)p->i * ADC_VREF) / ADC_RES;
+        sum_v += v;
+        sq_v  += v * v;
+        sq_i  += i * i;
+        vi    += v * i;
+        ema    = 0.3f * v + (1.0f - 0.3f) * ema;
+    }
+    s_sinkF = sqrtf(sq_v / n) + sqrtf(sq_i / n) + vi + sum_v + ema;
+}
+
+void SigBench_Fixed(const AdcScanFrame *p, uint16_t n)
+{
+    uint32_t sum_v = 0;
+    uint64_t sq_v = 0, sq_i = 0, vi = 0;
+    int32_t  ema = 0;
+
+    for (uint16_t k = 0; k < n; k++, p++)
+    {
+        uint32_t v = p->v, i = p->i;
+        sum_v += v;
+        sq_v  += v * v;
+        sq_i  += i * i;
+        vi    += v * i;
+        ema    = ema_q4_step(ema, (int32_t)v, FIX_ALPHA_Q8(0.3f));
+    }
+    uint32_t rv = cycle_rms_q8(sum_v, sq_v, n);
+    uint32_t ri = isqrt64(sq_i << 16) / n;
+    s_sinkU = rv + ri + (uint32_t)vi + (uint32_t)ema;
+    s_sinkF = (float)rv * (ADC_VREF / ADC_RES / 256.0f);
+}
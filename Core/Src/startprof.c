@@ -0,0 +1,284 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  START PROFILE – inrush / settle / running power per start
+ *
+ *  One current sample per mains cycle (uint16 mA, 400 B) is
+ *  enough: a PSC/CSR pump motor takes 100–800 ms to come off
+ *  its inrush, i.e. 5–40 cycles, and the settle search is done
+ *  once at the end of the window, not per cycle.
+ *
+ *  The window is indexed by the engine's cycle sequence, not by
+ *  calls: cycles the loop missed are marked lost, and cycle
+ *  time is the mean measured period of the capture.
+ ***************************************************************/
+
+#include "startprof.h"
+#include "acs712.h"
+#include "model_handle.h"
+#include "eeprom_i2c.h"
+#include "uart.h"
+#include "stm32f1xx_hal.h"
+#include <stdio.h>
+#include <math.h>
+
+#define STARTPROF_SIGNATURE   0x57A7
+#define NOMINAL_CYCLE_MS      20.0f         // until a period is measured
+#define MA_LOST               0xFFFFU       // s_mA slot the loop never saw
+
+typedef struct {
+    float    peakA;
+    float    settleMs;
+    float    steadyW;
+    uint16_t starts;
+    uint8_t  marginPct;
+    uint8_t  reserved;
+} StartProfRecord;
+
+static StartBaseline s_base = { .marginPct = STARTPROF_DEFAULT_MARGIN };
+
+static StartRecord s_log[STARTPROF_LOG_SIZE];
+static uint8_t     s_logHead  = 0;          // next slot
+static uint8_t     s_logCount = 0;
+static uint8_t     s_warn     = 0;
+
+/* capture window */
+static bool     s_capturing = false;
+static uint16_t s_n;
+static uint16_t s_mA[STARTPROF_WINDOW_CYCLES];
+static float    s_peakA;
+static float    s_sumW;
+static uint16_t s_steadyN;                  // steady-window cycles seen
+static uint32_t s_startMs;
+static uint32_t s_lastSeq;
+static uint16_t s_lost;
+static uint16_t s_firstLost;
+static float    s_periodSum;                // ms, synchronised cycles only
+static uint16_t s_periodN;
+
+static void save(void)
+{
+    StartProfRecord r = {0};
+    r.peakA     = s_base.peakA;
+    r.settleMs  = s_base.settleMs;
+    r.steadyW   = s_base.steadyW;
+    r.starts    = s_base.starts;
+    r.marginPct = s_base.marginPct;
+    EEPROM_WriteRecord(EE_ADDR_STARTPROF, &r, sizeof(r), STARTPROF_SIGNATURE);
+}
+
+void StartProf_Init(void)
+{
+    StartProfRecord r;
+
+    if (!EEPROM_ReadRecord(EE_ADDR_STARTPROF, &r, sizeof(r), STARTPROF_SIGNATURE))
+        return;
+    if (!isfinite(r.peakA) || !isfinite(r.settleMs) || !isfinite(r.steadyW))
+        return;
+
+    s_base.peakA     = r.peakA;
+    s_base.settleMs  = r.settleMs;
+    s_base.steadyW   = r.steadyW;
+    s_base.starts    = r.starts;
+    s_base.marginPct = r.marginPct;
+}
+
+void StartProf_OnStart(void)
+{
+    s_capturing = true;
+    s_n         = 0;
+    s_peakA     = 0.0f;
+    s_sumW      = 0.0f;
+    s_steadyN   = 0;
+    s_startMs   = HAL_GetTick();
+    s_lastSeq   = ACS712_GetCycleSeq();    // next cycle = slot 0
+    s_lost      = 0;
+    s_firstLost = STARTPROF_WINDOW_CYCLES;
+    s_periodSum = 0.0f;
+    s_periodN   = 0;
+}
+
+/* |v - ref| beyond pct of ref, and beyond minAbs (quantisation) */
+static bool off_by(float v, float ref, uint8_t pct, float minAbs)
+{
+    float lim = ref * (float)pct * 0.01f;
+    return fabsf(v - ref) > ((lim > minAbs) ? lim : minAbs);
+}
+
+static void finish(void)
+{
+    StartRecord r;
+    uint32_t    sumA = 0;
+
+    /* too little of the last second left for a steady state */
+    if (s_steadyN < STARTPROF_STEADY_CYCLES / 2U)
+        return;
+
+    for (uint16_t k = STARTPROF_WINDOW_CYCLES - STARTPROF_STEADY_CYCLES;
+         k < STARTPROF_WINDOW_CYCLES; k++)
+        if (s_mA[k] != MA_LOST)
+            sumA += s_mA[k];
+
+    uint32_t steady = sumA / s_steadyN;
+    if ((float)steady < STARTPROF_MIN_STEADY_A * 1000.0f)
+        return;                                 // relay on, no motor
+
+    /* last cycle outside the band, searched backwards */
+    uint32_t band   = steady * STARTPROF_SETTLE_PCT / 100U;
+    uint16_t settle = 0;
+
+    for (uint16_t k = STARTPROF_WINDOW_CYCLES; k > 0; k--)
+    {
+        uint32_t a = s_mA[k - 1];
+        if (a == MA_LOST)
+            continue;
+        if (a > steady + band || a + band < steady)
+        {
+            settle = k;
+            break;
+        }
+    }
+
+    /* inrush seen completely only if nothing was lost up to the
+       first in-band cycle after it: a gap there may hide the peak
+       and the true settle point */
+    uint16_t seenTo = settle;
+    while (seenTo < STARTPROF_WINDOW_CYCLES && s_mA[seenTo] == MA_LOST)
+        seenTo++;
+
+    float cycMs = s_periodN ? s_periodSum / (float)s_periodN : NOMINAL_CYCLE_MS;
+
+    r.peakA    = s_peakA;
+    r.settleMs = (float)settle * cycMs;
+    r.steadyW  = s_sumW / (float)s_steadyN;
+    r.atMs     = s_startMs;
+    r.warn     = 0;
+    r.lost     = (uint8_t)((s_lost > 0xFF) ? 0xFF : s_lost);
+    r.partial  = (s_firstLost <= seenTo);
+
+    if (!r.partial && s_base.starts >= STARTPROF_LEARN_STARTS && s_base.marginPct > 0)
+    {
+        uint8_t m = s_base.marginPct;
+
+        if (off_by(r.peakA,    s_base.peakA,    m, 0.0f))  r.warn |= STARTPROF_WARN_PEAK;
+        if (off_by(r.settleMs, s_base.settleMs, m, cycMs)) r.warn |= STARTPROF_WARN_SETTLE;
+        if (off_by(r.steadyW,  s_base.steadyW,  m, 0.0f))  r.warn |= STARTPROF_WARN_POWER;
+    }
+
+    s_log[s_logHead] = r;
+    s_logHead = (uint8_t)((s_logHead + 1U) % STARTPROF_LOG_SIZE);
+    if (s_logCount < STARTPROF_LOG_SIZE)
+        s_logCount++;
+
+    if (r.partial)
+        return;                                 // logged, but proves nothing
+
+    if (r.warn)
+    {
+        char line[24];
+        s_warn |= r.warn;
+        snprintf(line, sizeof(line), "START:WARN:%u", r.warn);
+        UART_TransmitPacket(line);
+        return;                                 // keep the baseline healthy
+    }
+
+    /* plain mean while learning, EMA 1/8 afterwards */
+    float k = (s_base.starts < STARTPROF_LEARN_STARTS)
+            ? 1.0f / (float)(s_base.starts + 1U)
+            : 0.125f;
+
+    s_base.peakA    += (r.peakA    - s_base.peakA)    * k;
+    s_base.settleMs += (r.settleMs - s_base.settleMs) * k;
+    s_base.steadyW  += (r.steadyW  - s_base.steadyW)  * k;
+    if (s_base.starts < 0xFFFF)
+        s_base.starts++;
+    save();
+}
+
+void StartProf_OnCycle(float currentA, float powerW, uint32_t seq, float hz)
+{
+    if (!s_capturing)
+        return;
+
+    if (!Motor_GetStatus())
+    {
+        s_capturing = false;                    // stopped early: no record
+        return;
+    }
+
+    /* cycles published while the loop was busy never got here */
+    uint32_t d = seq - s_lastSeq;
+    s_lastSeq = seq;
+
+    if (d == 0)
+        return;
+    for (; d > 1U && s_n < STARTPROF_WINDOW_CYCLES; d--)
+    {
+        if (s_firstLost == STARTPROF_WINDOW_CYCLES)
+            s_firstLost = s_n;
+        s_mA[s_n++] = MA_LOST;
+        s_lost++;
+    }
+
+    if (s_n < STARTPROF_WINDOW_CYCLES)
+    {
+        float mA = currentA * 1000.0f;
+        s_mA[s_n] = (mA >= (float)MA_LOST) ? (MA_LOST - 1U) : (uint16_t)mA;
+
+        if (currentA > s_peakA)
+            s_peakA = currentA;
+        if (s_n >= STARTPROF_WINDOW_CYCLES - STARTPROF_STEADY_CYCLES)
+        {
+            s_sumW += powerW;
+            s_steadyN++;
+        }
+        if (hz > 0.0f)
+        {
+            s_periodSum += 1000.0f / hz;
+            s_periodN++;
+        }
+        s_n++;
+    }
+
+    if (s_n >= STARTPROF_WINDOW_CYCLES)
+    {
+        s_capturing = false;
+        finish();
+    }
+}
+
+const StartBaseline* StartProf_GetBaseline(void)
+{
+    return &s_base;
+}
+
+const StartRecord* StartProf_GetLog(uint8_t back)
+{
+    if (back >= s_logCount)
+        return NULL;
+    return &s_log[(s_logHead + STARTPROF_LOG_SIZE - 1U - back) % STARTPROF_LOG_SIZE];
+}
+
+uint8_t StartProf_GetWarning(void)
+{
+    return s_warn;
+}
+
+void StartProf_ClearWarning(void)
+{
+    s_warn = 0;
+}
+
+void StartProf_SetMargin(uint8_t pct)
+{
+    s_base.marginPct = pct;
+    save();
+}
+
+void StartProf_ResetBaseline(void)
+{
+    uint8_t m = s_base.marginPct;
+
+    s_base = (StartBaseline){ .marginPct = m };
+    s_warn = 0;
+    save();
+}
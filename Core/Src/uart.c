@@ -30,6 +30,12 @@ void UART_TransmitString(UART_HandleTypeDef *huart, const char *s)
         HAL_UART_Transmit(huart, (uint8_t*)s, strlen(s), 100);
 }
 
+void UART_TransmitBinary(const uint8_t *buf, uint16_t len)
+{
+    if (buf && len)
+        HAL_UART_Transmit(&huart1, (uint8_t*)buf, len, 50);
+}
+
 void UART_TransmitPacket(const char *payload)
 {
     static char out[48];  // small, static TX buffer
@@ -3,6 +3,21 @@
 #include "model_handle.h"
 #include "relay.h"
 #include "rtc_i2c.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "meter.h"
+#include "acs712.h"
+#include "fasttrip.h"
+#include "faultcap.h"
+#include "calib.h"
+#include "drypower.h"
+#include "startprof.h"
+#include "level.h"
+#include "pressure_level.h"
+#include "powerq.h"
+#include "lcd_i2c.h"
+#include "lcd_fb.h"
+#include "lcd_cgram.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -38,7 +53,6 @@ static char* next_token(char** ctx) {
    ========================= */
 void UART_SendStatusPacket(void)
 {
-    extern ADC_Data adcData;
     extern volatile uint8_t motorStatus;
     extern volatile bool manualActive;
     extern volatile bool semiAutoActive;
@@ -46,10 +60,7 @@ void UART_SendStatusPacket(void)
     extern volatile bool countdownActive;
     extern volatile bool twistActive;
 
-    int submerged = 0;
-    for (int i = 0; i < 5; i++) {
-        if (adcData.voltages[i] < 0.1f) submerged++;
-    }
+    int submerged = Level_GetSubmerged();
 
     const char *mode = "IDLE";
     if (manualActive)         mode = "MANUAL";
@@ -272,6 +283,447 @@ void UART_HandleCommand(const char *pkt)
         return;
     }
 
+    /* ---- METER ----
+       @METER#  → "METER:<W>:<VA>:<PF>"
+                  "ENERGY:<run Wh>:<day Wh>:<life Wh>" */
+    else if (!strcmp(cmd, "METER")) {
+        const MeterReadings *m = Meter_Get();
+        char line[44];
+
+        snprintf(line, sizeof(line), "METER:%.1f:%.1f:%.2f",
+                 m->activeW, m->apparentVA, m->pf);
+        UART_TransmitPacket(line);
+
+        snprintf(line, sizeof(line), "ENERGY:%lu:%lu:%lu",
+                 (unsigned long)m->runWh,
+                 (unsigned long)m->dayWh,
+                 (unsigned long)m->lifeWh);
+        UART_TransmitPacket(line);
+        return;
+    }
+
+    /* ---- ACQ (V/I acquisition mode) ----
+       @ACQ#        → "ACQ:SEQ|DUAL" + last phase self-check
+       @ACQ:SEQ#    → sequential ADC1 scan
+       @ACQ:DUAL#   → ADC1/ADC2 regular simultaneous
+       @ACQ:CHECK#  → run the phase self-check (needs motor load) */
+    else if (!strcmp(cmd, "ACQ")) {
+        char* sub = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "SEQ"))       ACS712_SetAcqMode(MAINS_ACQ_SEQUENTIAL);
+        else if (sub && !strcmp(sub, "DUAL")) ACS712_SetAcqMode(MAINS_ACQ_DUAL);
+        else if (sub && !strcmp(sub, "CHECK")) {
+            if (ACS712_StartPhaseCheck()) ack("ACQ_CHECK");
+            else                          err("BUSY");
+            return;
+        }
+        else if (sub) { err("FORMAT"); return; }
+
+        ack(ACS712_GetAcqMode() == MAINS_ACQ_DUAL ? "ACQ:DUAL" : "ACQ:SEQ");
+
+        const MainsPhaseCheck *pc = ACS712_GetPhaseCheck();
+        char line[44];
+        switch (pc->state) {
+            case MAINS_PCHK_RUNNING: ack("PHASE:RUNNING"); break;
+            case MAINS_PCHK_NO_LOAD: ack("PHASE:NOLOAD");  break;
+            case MAINS_PCHK_DONE:
+                snprintf(line, sizeof(line), "PHASE:%.2f:%.2f:%.2f",
+                         pc->seqDeg, pc->dualDeg, pc->expectedDeg);
+                UART_TransmitPacket(line);
+                break;
+            default: break;
+        }
+        return;
+    }
+
+    /* ---- FTRIP (AWD overcurrent fast-trip) ----
+       @FTRIP#      → "FTRIP:<ON|OFF>:<ARMED|IDLE>:<trips>:<last us>:<worst us>:<trip A>:<mult>:<FIT|CLAMP>"
+                      (latency OVF = tripping sample older than the DMA ring)
+                      (trip A / mult / CLAMP: window of the last arming)
+       @FTRIP:ON#   / @FTRIP:OFF#  → enable / disable the hardware layer */
+    else if (!strcmp(cmd, "FTRIP")) {
+        char* sub = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "ON"))       FastTrip_SetEnabled(true);
+        else if (sub && !strcmp(sub, "OFF")) FastTrip_SetEnabled(false);
+        else if (sub) { err("FORMAT"); return; }
+
+        const FastTripStats *f = FastTrip_GetStats();
+        char line[80], last[12], worst[12];
+        if (f->lastLatencyCyc == FASTTRIP_LAT_OVERFLOW) strcpy(last, "OVF");
+        else snprintf(last, sizeof(last), "%lu", (unsigned long)Prof_CyclesToUs(f->lastLatencyCyc));
+        if (f->worstLatencyCyc == FASTTRIP_LAT_OVERFLOW) strcpy(worst, "OVF");
+        else snprintf(worst, sizeof(worst), "%lu", (unsigned long)Prof_CyclesToUs(f->worstLatencyCyc));
+        snprintf(line, sizeof(line), "FTRIP:%s:%s:%lu:%s:%s:%.1f:%.1f:%s",
+                 f->enabled ? "ON" : "OFF",
+                 f->armed ? "ARMED" : "IDLE",
+                 (unsigned long)f->trips,
+                 last, worst,
+                 f->tripA, f->mult,
+                 f->clamped ? "CLAMP" : "FIT");
+        UART_TransmitPacket(line);
+        return;
+    }
+
+    /* ---- CAL (mains V/I calibration) ----
+       @CAL#            → "CAL:V:<gain>:<offset>" + "CAL:I:<gain>:<offset>"
+       @CAL:V:<volts>#  → average CALIB_CYCLES against the reference,
+       @CAL:I:<amps>#     result is reported + saved when done
+       @CAL:RESET#      → factory factors */
+    else if (!strcmp(cmd, "CAL")) {
+        char* sub = next_token(&ctx);
+        char* val = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "RESET")) {
+            Calib_Reset();
+        }
+        else if (sub && (!strcmp(sub, "V") || !strcmp(sub, "I"))) {
+            if (!val) { err("FORMAT"); return; }
+
+            CalibChannel ch = (sub[0] == 'V') ? CALIB_CH_V : CALIB_CH_I;
+            if (Calib_Start(ch, strtof(val, NULL))) ack("CAL:RUN");
+            else                                    err("BUSY");
+            return;
+        }
+        else if (sub) { err("FORMAT"); return; }
+
+        const CalibFactors *c = Calib_Get();
+        char line[40];
+        snprintf(line, sizeof(line), "CAL:V:%.3f:%.3f",
+                 c->gain[CALIB_CH_V], c->offset[CALIB_CH_V]);
+        UART_TransmitPacket(line);
+        snprintf(line, sizeof(line), "CAL:I:%.3f:%.3f",
+                 c->gain[CALIB_CH_I], c->offset[CALIB_CH_I]);
+        UART_TransmitPacket(line);
+        return;
+    }
+
+    /* ---- DRYP (sensorless dry-run, power signature) ----
+       @DRYP#                 → "DRYP:<LEARNED|LEARNING|NONE>:<base W>:<base PF>:<frac %>:<cycles>:<WET|DRY|UNK>:<last W>"
+       @DRYP:LEARN#           → relearn the baseline on the next normal run
+       @DRYP:SET:<%>:<cyc>#   → DRY when W or PF below <%> of baseline for <cyc> cycles
+                                (0..100 %, 0 % = off; 1..DRYPOWER_MAX_CYCLES) */
+    else if (!strcmp(cmd, "DRYP")) {
+        char* sub = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "LEARN")) {
+            DryPower_Learn();
+        }
+        else if (sub && !strcmp(sub, "SET")) {
+            char* pct = next_token(&ctx);
+            char* cyc = next_token(&ctx);
+            if (!pct || !cyc) { err("FORMAT"); return; }
+            int p = atoi(pct), n = atoi(cyc);
+            if (p < 0 || p > 100 || n < 1 || n > DRYPOWER_MAX_CYCLES) { err("RANGE"); return; }
+            DryPower_SetThreshold((uint8_t)p, (uint16_t)n);
+        }
+        else if (sub) { err("FORMAT"); return; }
+
+        const DryPowerStats *d = DryPower_GetStats();
+        char line[64];
+        snprintf(line, sizeof(line), "DRYP:%s:%.0f:%.2f:%u:%u:%s:%.0f",
+                 d->learning ? "LEARNING" : (d->learned ? "LEARNED" : "NONE"),
+                 d->baseW, d->basePf, d->fracPct, d->nCycles,
+                 d->verdict == DRYPOWER_DRY ? "DRY" :
+                 (d->verdict == DRYPOWER_WET ? "WET" : "UNK"),
+                 d->lastW);
+        UART_TransmitPacket(line);
+        return;
+    }
+
+    /* ---- START (motor start profiling) ----
+       @START#             → "START:B:<peak A>:<settle ms>:<W>:<starts>:<margin %>:<warn>"
+                             + "START:<n>:<peak A>:<settle ms>:<W>:<warn>:<age s>:<lost>[:P]" per logged start
+                               (P = cycles lost in the inrush, not compared)
+       @START:MARGIN:<%>#  → deviation that raises the warning
+       @START:CLEAR#       → clear the latched warning
+       @START:RESET#       → forget the baseline, learn again */
+    else if (!strcmp(cmd, "START")) {
+        char* sub = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "CLEAR"))      StartProf_ClearWarning();
+        else if (sub && !strcmp(sub, "RESET")) StartProf_ResetBaseline();
+        else if (sub && !strcmp(sub, "MARGIN")) {
+            char* pct = next_token(&ctx);
+            if (!pct) { err("FORMAT"); return; }
+            StartProf_SetMargin((uint8_t)atoi(pct));
+        }
+        else if (sub) { err("FORMAT"); return; }
+
+        const StartBaseline *b = StartProf_GetBaseline();
+        char line[56];
+        snprintf(line, sizeof(line), "START:B:%.2f:%.0f:%.0f:%u:%u:%u",
+                 b->peakA, b->settleMs, b->steadyW,
+                 b->starts, b->marginPct, StartProf_GetWarning());
+        UART_TransmitPacket(line);
+
+        const StartRecord *r;
+        for (uint8_t n = 0; (r = StartProf_GetLog(n)) != NULL; n++) {
+            snprintf(line, sizeof(line), "START:%u:%.2f:%.0f:%.0f:%u:%lu:%u%s",
+                     n, r->peakA, r->settleMs, r->steadyW, r->warn,
+                     (unsigned long)((HAL_GetTick() - r->atMs) / 1000UL),
+                     r->lost, r->partial ? ":P" : "");
+            UART_TransmitPacket(line);
+        }
+        return;
+    }
+
+    /* ---- LEVEL (level source) ----
+       @LEVEL#                  → "LEVEL:<PROBES|LADDER>:<submerged>:<steps>:<raw>"
+                                  + "BAND:<k>:<centre>" per ladder band
+       @LEVEL:SRC:PROBES|LADDER|PRESSURE#
+       @LEVEL:STEPS:<n>#        → probes on the ladder (resets the bands)
+       @LEVEL:CAL:<k>#          → centre of band k = current reading
+       @LEVEL:HYST:<counts># */
+    else if (!strcmp(cmd, "LEVEL")) {
+        char* sub = next_token(&ctx);
+        char* val = next_token(&ctx);
+
+        if (sub && !val) { err("FORMAT"); return; }
+
+        if (sub && !strcmp(sub, "SRC")) {
+            if (!strcmp(val, "LADDER"))        Level_SetSource(LEVEL_SRC_LADDER);
+            else if (!strcmp(val, "PROBES"))   Level_SetSource(LEVEL_SRC_PROBES);
+            else if (!strcmp(val, "PRESSURE")) Level_SetSource(LEVEL_SRC_PRESSURE);
+            else { err("FORMAT"); return; }
+        }
+        else if (sub && !strcmp(sub, "STEPS")) {
+            if (!Level_SetLadderSteps((uint8_t)atoi(val))) { err("RANGE"); return; }
+        }
+        else if (sub && !strcmp(sub, "CAL")) {
+            if (!Level_CalibrateBand((uint8_t)atoi(val))) { err("RANGE"); return; }
+        }
+        else if (sub && !strcmp(sub, "HYST")) {
+            Level_SetHysteresis((uint16_t)atoi(val));
+        }
+        else if (sub) { err("FORMAT"); return; }
+
+        const LevelLadderCfg *l = Level_GetLadder();
+        char line[40];
+        static const char *const srcName[] = { "PROBES", "LADDER", "PRESSURE" };
+        snprintf(line, sizeof(line), "LEVEL:%s:%u:%u:%u",
+                 srcName[Level_GetSource()],
+                 Level_GetSubmerged(), Level_GetSteps(), Level_GetLadderRaw());
+        UART_TransmitPacket(line);
+
+        if (Level_GetSource() == LEVEL_SRC_LADDER) {
+            for (uint8_t k = 0; k <= l->steps; k++) {
+                snprintf(line, sizeof(line), "BAND:%u:%u", k, l->center[k]);
+                UART_TransmitPacket(line);
+            }
+        }
+        return;
+    }
+
+    /* ---- PLEV (pressure transducer level) ----
+       @PLEV#                         → "PLEV:<OK|FAULT>:<mm>:<%>:<raw>:<probe>:<faults>"
+                                        + "PTANK:<full mm>:<sensor mm>:<V|H>:<zero>:<span>:<fs mm>"
+       @PLEV:PRESET:<V05|MA420>:<fs mm>#
+       @PLEV:ZERO#                    → zero point = current reading (sensor in air)
+       @PLEV:TANK:<full mm>:<sensor mm>:<V|H>#
+       @PLEV:PROBE:<1..5># */
+    else if (!strcmp(cmd, "PLEV")) {
+        char* sub = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "PRESET")) {
+            char* type = next_token(&ctx);
+            char* fs   = next_token(&ctx);
+            if (!type) { err("FORMAT"); return; }
+            PLevel_ApplyPreset(!strcmp(type, "V05") ? PLEV_PRESET_V05 : PLEV_PRESET_MA420,
+                               fs ? (uint16_t)atoi(fs) : 0);
+        }
+        else if (sub && !strcmp(sub, "ZERO")) {
+            PLevel_CaptureZero();
+        }
+        else if (sub && !strcmp(sub, "TANK")) {
+            char* full  = next_token(&ctx);
+            char* smm   = next_token(&ctx);
+            char* shape = next_token(&ctx);
+            if (!full || !smm) { err("FORMAT"); return; }
+            if (!PLevel_SetTank((uint16_t)atoi(full), (uint16_t)atoi(smm),
+                                (shape && shape[0] == 'H') ? PLEV_TANK_HORIZONTAL
+                                                           : PLEV_TANK_VERTICAL)) {
+                err("RANGE"); return;
+            }
+        }
+        else if (sub && !strcmp(sub, "PROBE")) {
+            char* n = next_token(&ctx);
+            if (!n || !PLevel_SetProbe((uint8_t)atoi(n))) { err("RANGE"); return; }
+        }
+        else if (sub) { err("FORMAT"); return; }
+
+        const PlevConfig *c = PLevel_GetConfig();
+        char line[48];
+        snprintf(line, sizeof(line), "PLEV:%s:%u:%u:%u:%u:%u",
+                 PLevel_IsValid() ? "OK" : "FAULT",
+                 PLevel_GetMm(), PLevel_GetPercent(), PLevel_GetRaw(), c->probe,
+                 PLevel_GetFaultCount());
+        UART_TransmitPacket(line);
+        snprintf(line, sizeof(line), "PTANK:%u:%u:%c:%u:%u:%u",
+                 c->fullMm, c->sensorMm,
+                 c->shape == PLEV_TANK_HORIZONTAL ? 'H' : 'V',
+                 c->zeroCounts, c->spanCounts, c->fsMm);
+        UART_TransmitPacket(line);
+        return;
+    }
+
+    /* ---- PQ (power quality) ----
+       @PQ#        → "PQ:<Hz avg>:<Hz min>:<Hz max>:<V min>:<V max>:<sag>:<swell>:<int>:<freq>:<lost>"
+       @PQ:LOG#    → "PQE:<n>:<SAG|SWELL|INT|FREQ|BOOT>:<yy-mm-dd hh:mm:ss>:<ms>:<V x10 | Hz x100>"
+                     newest first, one per UART pass, then "PQE:END"
+       @PQ:CLEAR#  → "PQ:CLEARING", then "PQ:CLEARED" (or "PQ:CLEAR:FAIL")
+                     once the log + counters are erased */
+    else if (!strcmp(cmd, "PQ")) {
+        char* sub = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "LOG")) {
+            if (!PowerQ_StartDump()) err("PQ:EMPTY");
+            return;
+        }
+        if (sub && !strcmp(sub, "CLEAR")) {
+            PowerQ_Clear();
+            UART_TransmitPacket("PQ:CLEARING");
+            return;
+        }
+        if (sub) { err("FORMAT"); return; }
+
+        const PqStats *q = PowerQ_GetStats();
+        char line[80];
+        snprintf(line, sizeof(line), "PQ:%.2f:%.2f:%.2f:%.0f:%.0f:%u:%u:%u:%u:%lu",
+                 q->hzAvg,
+                 q->cycles ? q->hzMin : 0.0f, q->hzMax,
+                 q->cycles ? q->vMin  : 0.0f, q->vMax,
+                 q->count[PQ_EVT_SAG], q->count[PQ_EVT_SWELL],
+                 q->count[PQ_EVT_INTERRUPTION], q->count[PQ_EVT_FREQ],
+                 (unsigned long)q->lost);
+        UART_TransmitPacket(line);
+        return;
+    }
+
+    /* ---- LCD (display transport) ----
+       @LCD#        → "LCD:<flushes>:<chars>:<skipped>:<i2cBytes>:<errors>:<glyphUploads>"
+       @LCD:BENCH#  → "LCDB:OLD:<bytes>:<us>:NEW:<bytes>:<us>" for one
+                      16-char lcd_send_string (blocks ~200 ms) */
+    else if (!strcmp(cmd, "LCD")) {
+        char* sub = next_token(&ctx);
+        char line[64];
+
+        if (sub && !strcmp(sub, "BENCH")) {
+            LcdBench b;
+            lcd_bench_string("0123456789ABCDEF", &b);
+            lcd_fb_invalidate();
+            snprintf(line, sizeof(line), "LCDB:OLD:%lu:%lu:NEW:%lu:%lu",
+                     (unsigned long)b.oldBytes, (unsigned long)b.oldUs,
+                     (unsigned long)b.newBytes, (unsigned long)b.newUs);
+            UART_TransmitPacket(line);
+            return;
+        }
+        if (sub) { err("FORMAT"); return; }
+
+        const LcdFbStats    *f = lcd_fb_stats();
+        const LcdAsyncStats *a = lcd_async_stats();
+        snprintf(line, sizeof(line), "LCD:%lu:%lu:%lu:%lu:%u:%lu",
+                 (unsigned long)f->flushes, (unsigned long)f->charsSent,
+                 (unsigned long)f->skipped, (unsigned long)a->bytes,
+                 a->errors, (unsigned long)lcd_cgram_stats()->uploads);
+        UART_TransmitPacket(line);
+        return;
+    }
+
+    /* ---- CAP (fault waveform capture) ----
+       @CAP#        → "CAP:ARMED|POST|FROZEN"
+       @CAP:DUMP#   → binary frames (see faultcap.h) of the frozen ring
+       @CAP:ARM#    → discard the capture, record again */
+    else if (!strcmp(cmd, "CAP")) {
+        char* sub = next_token(&ctx);
+
+        if (sub && !strcmp(sub, "DUMP")) {
+            if (!FaultCap_StartDump()) err("CAP:EMPTY");
+            return;
+        }
+        if (sub && !strcmp(sub, "ARM"))   FaultCap_Arm();
+        else if (sub) { err("FORMAT"); return; }
+
+        switch (FaultCap_GetState()) {
+            case FAULTCAP_POST:   ack("CAP:POST");   break;
+            case FAULTCAP_FROZEN: ack("CAP:FROZEN"); break;
+            default:              ack("CAP:ARMED");  break;
+        }
+        return;
+    }
+
+    /* ---- SCHED ----
+       @SCHED#        → one packet per task: name, overruns, skipped, worst ms
+       @SCHED:RESET#  → clear counters */
+    else if (!strcmp(cmd, "SCHED")) {
+        char* sub = next_token(&ctx);
+        if (sub && !strcmp(sub, "RESET")) {
+            Scheduler_ResetStats();
+            ack("SCHED_RESET");
+            return;
+        }
+
+        char line[44];
+        for (uint8_t i = 0; i < Scheduler_GetTaskCount(); i++) {
+            const SchedTask      *t  = Scheduler_GetTask(i);
+            const SchedTaskStats *st = Scheduler_GetStats(i);
+            snprintf(line, sizeof(line), "SCHED:%s:O%lu:S%lu:W%u",
+                     t->name,
+                     (unsigned long)st->overruns,
+                     (unsigned long)st->skipped,
+                     (unsigned)st->worst_ms);
+            UART_TransmitPacket(line);
+        }
+        return;
+    }
+
+    /* ---- PROF ----
+       @PROF#        → per stage: "PROF:<stage>:<n>:<min>:<mean>:<max>" (us)
+                       then       "PH:<stage>:<bin0>,<bin1>,..." (log2 us bins)
+       @PROF:RESET#  → clear all stages
+       @PROF:BENCH#  → "BENCH:FLT:<cyc>:FIX:<cyc>" per V/I sample pair */
+    else if (!strcmp(cmd, "PROF")) {
+        char* sub = next_token(&ctx);
+        if (sub && !strcmp(sub, "RESET")) {
+            Prof_Reset();
+            ack("PROF_RESET");
+            return;
+        }
+        if (sub && !strcmp(sub, "BENCH")) {
+            MainsBench b;
+            char line[40];
+            ACS712_BenchSignalPath(&b);
+            snprintf(line, sizeof(line), "BENCH:FLT:%lu:FIX:%lu",
+                     (unsigned long)b.floatCycPerSample,
+                     (unsigned long)b.fixedCycPerSample);
+            UART_TransmitPacket(line);
+            return;
+        }
+
+        char line[48];
+        char hist[120];
+        for (uint8_t i = 0; i < PROF_STAGE_COUNT; i++) {
+            const ProfStats *p = Prof_GetStats((ProfStage)i);
+            uint32_t mean = p->count ? (uint32_t)(p->sum_cyc / p->count) : 0;
+
+            snprintf(line, sizeof(line), "PROF:%s:%lu:%lu:%lu:%lu",
+                     Prof_StageName((ProfStage)i),
+                     (unsigned long)p->count,
+                     (unsigned long)Prof_CyclesToUs(p->count ? p->min_cyc : 0),
+                     (unsigned long)Prof_CyclesToUs(mean),
+                     (unsigned long)Prof_CyclesToUs(p->max_cyc));
+            UART_TransmitPacket(line);
+
+            /* histogram is longer than a status packet – frame it here */
+            int n = snprintf(hist, sizeof(hist), "@PH:%s:", Prof_StageName((ProfStage)i));
+            for (uint8_t b = 0; b < PROF_HIST_BINS && n < (int)sizeof(hist) - 8; b++)
+                n += snprintf(hist + n, sizeof(hist) - n, b ? ",%u" : "%u", p->hist[b]);
+            snprintf(hist + n, sizeof(hist) - n, "#");
+            UART_TransmitString(&huart1, hist);
+        }
+        return;
+    }
+
     else {
 //        err("UNKNOWN");
         return;
@@ -0,0 +1,234 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  HOST TEST – pressure transducer level (pressure_level.c)
+ *
+ *  Simulated ADC source: PLevel_Feed takes plain counts, the
+ *  ADC and EEPROM are stubbed below. PLevel_SetProbe reseeds
+ *  the EMA, so one feed after it gives an exact reading.
+ ***************************************************************/
+
+#include "pressure_level.h"
+#include "adc.h"
+#include "eeprom_i2c.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ---- stubs ---- */
+static uint16_t s_adcCounts;
+static uint8_t  s_ee[64];
+
+uint16_t ADC_GetFilteredCounts(uint8_t ch)
+{
+    (void)ch;
+    return s_adcCounts;
+}
+
+HAL_StatusTypeDef EEPROM_WriteRecord(uint16_t memAddr, const void *payload, uint16_t len, uint16_t sig)
+{
+    if (memAddr != EE_ADDR_PLEVEL || len + 2U > sizeof(s_ee))
+        return HAL_ERROR;
+    memcpy(s_ee, payload, len);
+    memcpy(&s_ee[len], &sig, 2);
+    return HAL_OK;
+}
+
+bool EEPROM_ReadRecord(uint16_t memAddr, void *payload, uint16_t len, uint16_t sig)
+{
+    if (memAddr != EE_ADDR_PLEVEL || len + 2U > sizeof(s_ee) || memcmp(&s_ee[len], &sig, 2))
+        return false;
+    memcpy(payload, s_ee, len);
+    return true;
+}
+
+/* ---- helpers ---- */
+static int s_fail;
+
+#define CHECK(cond) do { if (!(cond)) { \
+    printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); s_fail++; } } while (0)
+
+static void feed_exact(uint16_t counts)
+{
+    PLevel_SetProbe(PLevel_GetConfig()->probe);     // reseed the EMA
+    PLevel_Feed(counts);
+}
+
+/* 1 count = 1 mm: full scale = span */
+static void one_mm_per_count(void)
+{
+    PLevel_ApplyPreset(PLEV_PRESET_MA420, PLEV_MA420_SPAN);
+}
+
+/* ---- tests ---- */
+static void test_presets(void)
+{
+    PLevel_ApplyPreset(PLEV_PRESET_V05, 5000);
+    PLevel_SetTank(6000, 0, PLEV_TANK_VERTICAL);
+    CHECK(PLevel_GetConfig()->zeroCounts == PLEV_V05_ZERO);
+    CHECK(PLevel_GetConfig()->spanCounts == PLEV_V05_SPAN);
+    feed_exact(PLEV_V05_ZERO);
+    CHECK(PLevel_IsValid() && PLevel_GetMm() == 0);
+    feed_exact(PLEV_V05_ZERO + PLEV_V05_SPAN);
+    CHECK(PLevel_GetMm() == 5000);
+    feed_exact(PLEV_V05_ZERO + PLEV_V05_SPAN / 2);
+    CHECK(PLevel_GetMm() == 2500);
+
+    PLevel_ApplyPreset(PLEV_PRESET_MA420, 5000);
+    CHECK(PLevel_GetConfig()->zeroCounts == PLEV_MA420_ZERO);
+    CHECK(PLevel_GetConfig()->spanCounts == PLEV_MA420_SPAN);
+    feed_exact(PLEV_MA420_ZERO);
+    CHECK(PLevel_IsValid() && PLevel_GetMm() == 0);
+    feed_exact(PLEV_MA420_ZERO + PLEV_MA420_SPAN);
+    CHECK(PLevel_GetMm() == 5000);
+
+    /* fsMm 0 keeps the current full scale */
+    PLevel_ApplyPreset(PLEV_PRESET_V05, 0);
+    CHECK(PLevel_GetConfig()->fsMm == 5000);
+
+    /* sensor mounted above the bottom */
+    PLevel_SetTank(6000, 300, PLEV_TANK_VERTICAL);
+    feed_exact(PLEV_V05_ZERO);
+    CHECK(PLevel_GetMm() == 300);
+}
+
+static void test_vertical(void)
+{
+    one_mm_per_count();
+    PLevel_SetTank(1000, 0, PLEV_TANK_VERTICAL);
+
+    feed_exact(PLEV_MA420_ZERO);
+    CHECK(PLevel_GetPercent() == 0);
+    feed_exact(PLEV_MA420_ZERO + 250);
+    CHECK(PLevel_GetPercent() == 25);
+    feed_exact(PLEV_MA420_ZERO + 500);
+    CHECK(PLevel_GetPercent() == 50);
+    feed_exact(PLEV_MA420_ZERO + 1000);
+    CHECK(PLevel_GetPercent() == 100);
+    feed_exact(PLEV_MA420_ZERO + 1400);            // overfilled, clamped
+    CHECK(PLevel_GetPercent() == 100);
+}
+
+static void test_horizontal(void)
+{
+    /* volume ‰ of a horizontal cylinder at fill height h/D */
+    static const struct { uint16_t mm; uint8_t pct; } pts[] = {
+        {    0,   0 }, {  100,   5 }, {  200,  14 }, {  250,  20 },
+        {  500,  50 }, {  800,  86 }, {  900,  95 }, { 1000, 100 },
+    };
+
+    one_mm_per_count();
+    PLevel_SetTank(1000, 0, PLEV_TANK_HORIZONTAL);
+
+    for (unsigned i = 0; i < sizeof(pts) / sizeof(pts[0]); i++)
+    {
+        feed_exact((uint16_t)(PLEV_MA420_ZERO + pts[i].mm));
+        if (PLevel_GetPercent() != pts[i].pct)
+            printf("  h=%u mm: %u %%, want %u %%\n",
+                   pts[i].mm, PLevel_GetPercent(), pts[i].pct);
+        CHECK(PLevel_GetPercent() == pts[i].pct);
+    }
+
+    /* symmetric about half full */
+    feed_exact(PLEV_MA420_ZERO + 300);
+    uint8_t low = PLevel_GetPercent();
+    feed_exact(PLEV_MA420_ZERO + 700);
+    CHECK(low + PLevel_GetPercent() == 100);
+}
+
+static void test_full_hysteresis(void)
+{
+    one_mm_per_count();
+    PLevel_SetTank(1000, 0, PLEV_TANK_VERTICAL);
+
+    feed_exact(PLEV_MA420_ZERO + 999);
+    CHECK(!PLevel_IsFull());
+    feed_exact(PLEV_MA420_ZERO + 1000);
+    CHECK(PLevel_IsFull());
+
+    /* stays full inside the band, drops below it */
+    feed_exact(PLEV_MA420_ZERO + 1000 - PLEV_FULL_HYST_MM);
+    CHECK(PLevel_IsFull());
+    feed_exact(PLEV_MA420_ZERO + 1000 - PLEV_FULL_HYST_MM - 1);
+    CHECK(!PLevel_IsFull());
+
+    /* and needs the full level again to re-latch */
+    feed_exact(PLEV_MA420_ZERO + 999);
+    CHECK(!PLevel_IsFull());
+    feed_exact(PLEV_MA420_ZERO + 1000);
+    CHECK(PLevel_IsFull());
+}
+
+static void test_fault(void)
+{
+    one_mm_per_count();
+    PLevel_SetTank(1000, 0, PLEV_TANK_VERTICAL);
+
+    uint16_t faults = PLevel_GetFaultCount();
+
+    feed_exact(PLEV_MA420_ZERO - PLEV_FAULT_COUNTS);     // edge: still valid
+    CHECK(PLevel_IsValid());
+    CHECK(!PLevel_IsFull());
+    CHECK(PLevel_GetMm() == 0);
+
+    feed_exact(PLEV_MA420_ZERO - PLEV_FAULT_COUNTS - 1); // open loop
+    CHECK(!PLevel_IsValid());
+    CHECK(PLevel_IsFull());                              // fail-safe
+    CHECK(PLevel_GetMm() == 0 && PLevel_GetPercent() == 0);
+    CHECK(PLevel_GetFaultCount() == faults + 1);
+
+    /* a wire dropping out while filtered: the EMA gets there too */
+    feed_exact(PLEV_MA420_ZERO + 500);
+    CHECK(PLevel_IsValid() && !PLevel_IsFull());
+    for (int i = 0; i < 400; i++)
+        PLevel_Feed(0);
+    CHECK(!PLevel_IsValid() && PLevel_IsFull());
+    CHECK(PLevel_GetFaultCount() == faults + 2);
+
+    /* recovers once the loop is back */
+    feed_exact(PLEV_MA420_ZERO + 500);
+    CHECK(PLevel_IsValid() && !PLevel_IsFull());
+}
+
+static void test_update_and_persist(void)
+{
+    one_mm_per_count();
+    PLevel_SetTank(1200, 50, PLEV_TANK_HORIZONTAL);
+
+    /* PLevel_Update pulls the ADC source */
+    PLevel_SetProbe(3);
+    s_adcCounts = PLEV_MA420_ZERO + 100;
+    PLevel_Update();
+    CHECK(PLevel_GetRaw() == PLEV_MA420_ZERO + 100);
+    CHECK(PLevel_GetMm() == 150);
+
+    /* zero capture reads the same source */
+    s_adcCounts = 800;
+    PLevel_CaptureZero();
+    CHECK(PLevel_GetConfig()->zeroCounts == 800);
+
+    /* what was saved comes back */
+    PlevConfig before = *PLevel_GetConfig();
+    PLevel_ApplyPreset(PLEV_PRESET_V05, 4000);
+    PLevel_Init();
+    CHECK(PLevel_GetConfig()->zeroCounts == PLEV_V05_ZERO);
+    CHECK(PLevel_GetConfig()->fsMm == 4000);
+    CHECK(PLevel_GetConfig()->probe == before.probe);
+    CHECK(PLevel_GetConfig()->fullMm == before.fullMm);
+
+    /* out-of-range setters are refused */
+    CHECK(!PLevel_SetProbe(0));
+    CHECK(!PLevel_SetProbe(ADC_CHANNEL_COUNT));
+    CHECK(!PLevel_SetTank(0, 0, PLEV_TANK_VERTICAL));
+}
+
+int main(void)
+{
+    test_presets();
+    test_vertical();
+    test_horizontal();
+    test_full_hysteresis();
+    test_fault();
+    test_update_and_persist();
+
+    printf("%s: %d failure(s)\n", s_fail ? "FAIL" : "OK", s_fail);
+    return s_fail ? 1 : 0;
+}
@@ -0,0 +1,283 @@
+/***************************************************************
+ *  HELONIX Water Pump Controller
+ *  HOST TEST – integer signal path (fixmath.h, sigbench.c)
+ *
+ *  Asserts isqrt32/isqrt64, cycle_rms_q8, ema_q4_step and
+ *  trim_mean_u16 against double references, then times both
+ *  @PROF:BENCH# kernels over a synthetic 50 Hz block and the
+ *  probe decimation candidates of AdcScan_BlockReady (plain
+ *  mean, median, trimmed mean). Host ns are only a
+ *  relative figure: the PC has an FPU, the F103 does not, so
+ *  the on-target DWT numbers remain the reference.
+ ***************************************************************/
+
+#include "sigbench.h"
+#include "acs712.h"
+#include "fixmath.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_BLOCKS   20000
+#define PRB_N          6            // ADC_SCAN_PROBES
+#define PRB_SUB        8            // ADC_SCAN_PROBE_SUBBLOCKS
+
+static int s_fail;
+
+#define CHECK(cond) do { if (!(cond)) { \
+    printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); s_fail++; } } while (0)
+
+/* deterministic, so a failure reproduces */
+static uint64_t s_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rng64(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 7;
+    s_rng ^= s_rng << 17;
+    return s_rng;
+}
+
+static AdcScanFrame s_blk[MAINS_BLOCK_SAMPLES];
+
+/* V and I around mid-scale, I lagging by phi, with a little noise */
+static void make_block(double vPk, double iPk, double phi)
+{
+    for (int n = 0; n < MAINS_BLOCK_SAMPLES; n++)
+    {
+        double w = 2.0 * M_PI * n / MAINS_BLOCK_SAMPLES;
+        s_blk[n].v = (uint16_t)lround(2048.0 + vPk * sin(w) + (double)(rng64() % 5) - 2.0);
+        s_blk[n].i = (uint16_t)lround(2048.0 + iPk * sin(w - phi) + (double)(rng64() % 5) - 2.0);
+    }
+}
+
+/* ---- tests ---- */
+static uint64_t isqrt_ref(uint64_t x)
+{
+    uint64_t r = (uint64_t)sqrtl((long double)x);
+    while (r * r > x) r--;
+    while (r < 0xFFFFFFFFULL && (r + 1) * (r + 1) <= x) r++;
+    return r;
+}
+
+static void test_isqrt(void)
+{
+    static const uint64_t edges[] = {
+        0, 1, 2, 3, 4, 15, 16, 17, 65535, 65536,
+        0xFFFFFFFEULL, 0xFFFFFFFFULL, 0x100000000ULL,
+        0xFFFFFFFE00000001ULL,                   // (2^32 - 1)^2
+        0xFFFFFFFFFFFFFFFFULL,
+    };
+
+    for (unsigned k = 0; k < sizeof(edges) / sizeof(edges[0]); k++)
+        CHECK(isqrt64(edges[k]) == isqrt_ref(edges[k]));
+
+    /* squares and their neighbours across the whole 32-bit root range */
+    for (uint32_t r = 1; r < 0xFFFF0000U; r += 65521U)
+    {
+        uint64_t sq = (uint64_t)r * r;
+        CHECK(isqrt64(sq) == r);
+        CHECK(isqrt64(sq - 1) == r - 1);
+        CHECK(isqrt64(sq + 1) == r);
+    }
+
+    for (int k = 0; k < 100000; k++)
+    {
+        uint64_t x = rng64() >> (rng64() % 64);
+        uint32_t y = (uint32_t)rng64();
+
+        if (isqrt64(x) != isqrt_ref(x)) { CHECK(isqrt64(x) == isqrt_ref(x)); break; }
+        if (isqrt32(y) != isqrt_ref(y)) { CHECK(isqrt32(y) == isqrt_ref(y)); break; }
+    }
+}
+
+static void test_cycle_rms(void)
+{
+    static const double amp[] = { 0.0, 10.0, 300.0, 1000.0, 2000.0 };
+
+    for (unsigned a = 0; a < sizeof(amp) / sizeof(amp[0]); a++)
+    {
+        make_block(amp[a], amp[a] / 3.0, 0.5);
+
+        uint32_t sum = 0;
+        uint64_t sq  = 0;
+        double   m = 0.0, ref = 0.0;
+
+        for (int n = 0; n < MAINS_BLOCK_SAMPLES; n++)
+        {
+            sum += s_blk[n].v;
+            sq  += (uint64_t)s_blk[n].v * s_blk[n].v;
+            m   += s_blk[n].v;
+        }
+        m /= MAINS_BLOCK_SAMPLES;
+        for (int n = 0; n < MAINS_BLOCK_SAMPLES; n++)
+            ref += (s_blk[n].v - m) * (s_blk[n].v - m);
+        ref = sqrt(ref / MAINS_BLOCK_SAMPLES);
+
+        /* floor of the root, then floor of /n: within one Q8 step */
+        double got = cycle_rms_q8(sum, sq, MAINS_BLOCK_SAMPLES) / 256.0;
+        if (fabs(got - ref) > 1.0 / 256.0)
+            printf("  amp %.0f: rms %.5f, libm %.5f\n", amp[a], got, ref);
+        CHECK(fabs(got - ref) <= 1.0 / 256.0);
+    }
+}
+
+static void test_ema(void)
+{
+    static const float alphas[] = { 0.05f, 0.1f, 0.3f, 0.5f };
+
+    for (unsigned a = 0; a < sizeof(alphas) / sizeof(alphas[0]); a++)
+    {
+        int32_t q4  = 0;
+        double  ref = 0.0;
+        double  al  = FIX_ALPHA_Q8(alphas[a]) / 256.0;   // the Q8 alpha itself
+        double  worst = 0.0;
+
+        for (int k = 0; k < 5000; k++)
+        {
+            int32_t x = (k < 2500) ? (int32_t)(rng64() % 4096) : 3000;
+
+            q4  = ema_q4_step(q4, x, FIX_ALPHA_Q8(alphas[a]));
+            ref = ref + (x - ref) * al;
+            if (fabs(q4 / 16.0 - ref) > worst)
+                worst = fabs(q4 / 16.0 - ref);
+        }
+
+        /* the Q8 step stops moving once |target - state| * alpha < 256,
+           a dead band of 256 / alpha Q4 units; the state never
+           strays further than that from the exact EMA            */
+        double band = 256.0 / FIX_ALPHA_Q8(alphas[a]) / 16.0;
+        if (worst > band)
+            printf("  alpha %.2f: off by %.3f, band %.3f counts\n", alphas[a], worst, band);
+        CHECK(worst <= band);
+        CHECK(fabs(q4 / 16.0 - 3000.0) <= band);
+    }
+}
+
+static void test_trim_mean(void)
+{
+    uint16_t v[PRB_SUB];
+
+    for (int k = 0; k < 20000; k++)
+    {
+        uint8_t n = (uint8_t)(3 + rng64() % 6);
+        double  sum = 0.0;
+        uint16_t lo = 0xFFFF, hi = 0;
+
+        for (uint8_t j = 0; j < n; j++)
+        {
+            v[j] = (uint16_t)(rng64() % 4096);
+            sum += v[j];
+            if (v[j] < lo) lo = v[j];
+            if (v[j] > hi) hi = v[j];
+        }
+
+        double ref = (sum - lo - hi) / (n - 2);
+        uint16_t got = trim_mean_u16(v, n);
+        if (fabs(got - ref) > 0.5) { CHECK(fabs(got - ref) <= 0.5); break; }
+    }
+
+    /* one splash up and one dropout down in a steady probe */
+    for (uint8_t j = 0; j < PRB_SUB; j++)
+        v[j] = 1800;
+    v[2] = 4095;
+    v[6] = 0;
+    CHECK(trim_mean_u16(v, PRB_SUB) == 1800);
+}
+
+static double bench_ns(void (*fn)(const AdcScanFrame*, uint16_t))
+{
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int b = 0; b < BENCH_BLOCKS; b++)
+        fn(s_blk, MAINS_BLOCK_SAMPLES);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+    return ns / ((double)BENCH_BLOCKS * MAINS_BLOCK_SAMPLES);
+}
+
+/* the three decimations over one block's 6 x 8 sub-block means */
+static uint16_t s_sub[PRB_N][PRB_SUB];
+static volatile uint16_t s_sink;
+
+static void dec_mean(void)
+{
+    for (uint8_t p = 0; p < PRB_N; p++)
+    {
+        uint32_t sum = 0;
+        for (uint8_t s = 0; s < PRB_SUB; s++)
+            sum += s_sub[p][s];
+        s_sink = (uint16_t)((sum + PRB_SUB / 2) / PRB_SUB);
+    }
+}
+
+static void dec_median(void)
+{
+    uint16_t tmp[PRB_SUB];
+
+    for (uint8_t p = 0; p < PRB_N; p++)
+    {
+        for (uint8_t s = 0; s < PRB_SUB; s++)
+            tmp[s] = s_sub[p][s];
+        s_sink = median_u16(tmp, PRB_SUB);
+    }
+}
+
+static void dec_trim(void)
+{
+    for (uint8_t p = 0; p < PRB_N; p++)
+        s_sink = trim_mean_u16(s_sub[p], PRB_SUB);
+}
+
+static double bench_dec_ns(void (*fn)(void))
+{
+    struct timespec t0, t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int b = 0; b < BENCH_BLOCKS * 10; b++)
+    {
+        s_sub[b % PRB_N][b % PRB_SUB] = (uint16_t)(1800 + (b & 63));
+        fn();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+    return ns / (BENCH_BLOCKS * 10.0);
+}
+
+static void bench(void)
+{
+    make_block(1000.0, 300.0, 0.5);
+
+    double f = bench_ns(SigBench_Float);
+    double x = bench_ns(SigBench_Fixed);
+
+    printf("BENCH: float %.2f ns/sample, fixed %.2f ns/sample (host, %d blocks)\n",
+           f, x, BENCH_BLOCKS);
+
+    for (uint8_t p = 0; p < PRB_N; p++)
+        for (uint8_t s = 0; s < PRB_SUB; s++)
+            s_sub[p][s] = (uint16_t)(1800 + (rng64() % 64));
+
+    double dm = bench_dec_ns(dec_mean);
+    double dd = bench_dec_ns(dec_median);
+    double dt = bench_dec_ns(dec_trim);
+
+    printf("BENCH: probe decimation mean %.1f, median %.1f, trimmed %.1f ns/block (host)\n",
+           dm, dd, dt);
+}
+
+int main(void)
+{
+    test_isqrt();
+    test_cycle_rms();
+    test_ema();
+    test_trim_mean();
+    bench();
+
+    printf("%s: %d failure(s)\n", s_fail ? "FAIL" : "OK", s_fail);
+    return s_fail ? 1 : 0;
+}